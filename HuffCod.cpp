@@ -26,16 +26,37 @@
 /* functions_and_structs header file */
 #include "functions_and_structs.h"
 
+/* batch_mode header file */
+#include "batch_mode.h"
+
+/* wide_alphabet header file */
+#include "wide_alphabet.h"
+
+/* ans_coding header file */
+#include "ans_coding.h"
+
+/* benchmark header file */
+#include "benchmark.h"
+
+/* compression_service header file */
+#include "compression_service.h"
+
+/* service_client header file */
+#include "service_client.h"
+
+/* filesystem library. */
+#include <filesystem>
+
 /**
 * @brief Check number of arguments inputed.
-* @details This function checks if the number of arguments inputed is even or if there is more than nine arguments.
+* @details This function checks if the number of arguments inputed is even or if there is more than fifteen arguments.
 * If either is the case it returns false.
 * @param numberOfArguments - number of arguments that have been inputed
 * @return Returns boolean value of 'true' if the number of inputed arguments is correct. False if it isn't.
 */
 bool ControlForNumberOfArguments(const int& numberOfArguments)
 {
-	if (!(numberOfArguments % 2) || numberOfArguments > 9)
+	if (!(numberOfArguments % 2) || numberOfArguments > 15)
 	{
 		std::cout << std::endl <<  "Inappropriate number of arguments used. Aborted." << std::endl;
 		return false;
@@ -43,6 +64,37 @@ bool ControlForNumberOfArguments(const int& numberOfArguments)
 	return true;
 }
 
+/* Biggest number of threads accepted by "-j". */
+constexpr unsigned int maximumNumberOfThreads = 256;
+
+/* Biggest number of requests accepted by "-n". */
+constexpr unsigned int maximumNumberOfRequests = 1000000;
+
+/**
+* @brief Parses the argument of a switch taking a number.
+* @details Only decimal digits are accepted and the value is checked against the bound while it is read, so it cannot overflow.
+* @param text Argument of the switch.
+* @param maximum Biggest accepted value.
+* @param result Parsed value, passed as a reference.
+* @return Returns true if the argument is a number not bigger than the maximum, false otherwise.
+*/
+bool ParseNumberArgument(const std::string& text, unsigned int maximum, unsigned int& result)
+{
+	if (text.empty())
+		return false;
+	unsigned long long value = 0;
+	for (char el : text)
+	{
+		if (el < '0' || el > '9')
+			return false;
+		value = value * 10 + (el - '0');
+		if (value > maximum)
+			return false;
+	}
+	result = static_cast<unsigned int>(value);
+	return true;
+}
+
 /**
 * @brief Make map of arguments and check if correct switches are present.
 * @details This function makes a map consisting of inputed arguments and checks if correct switches are present.
@@ -51,6 +103,15 @@ bool ControlForNumberOfArguments(const int& numberOfArguments)
 * 1. Map contains all relevant switches for the program to function.
 * 2. The switches "-i", "-o" and "-s" have non empty arguments.
 * 3. The switch "-t" has either of releveant arguments (either "k" or "d").
+* When the switch "-b" is present the program runs in batch mode, then only "-t" ("k" or "d") and non empty "-b" are required,
+* "-o" (output directory) and "-j" (number of threads, from 0 meaning all hardware threads up to 256) are optional and "-i" and "-s" are not used.
+* The optional switch "-a" chooses the alphabet, either "8" (characters, the default), "16" (16-bit samples) or "dg" (byte pairs).
+* The optional switch "-e" chooses the entropy coder, either "h" (huffman's coding, the default) or "ans" (tANS).
+* When "-t" is "b" the file passed through "-i" is only used to compare both entropy coders, other switches are not required.
+* When "-t" is "serve" the program runs the compression service on the socket passed through "-u",
+* with dictionaries only in the directory passed through "-s", "-j" is optional.
+* When "-t" is "client" the request passed through "-c" ("k", "d", "t" or "q") is sent to the service on the socket passed through "-u",
+* with "-i", "-o" and "-s" used as for "k" and "d", and the optional "-n" telling how many times to send it (up to 1000000).
 * @param numberOfArguments Is used as index to assign values to the map.
 * @param arguments Arguments passed through console.
 * @return Map of switches assigned relevant arguments for them.
@@ -63,6 +124,82 @@ std::map<std::string, std::string> ControlForArguments (const int& numberOfArgum
 	{
 		mapOfArguments[arguments[i]] = arguments[i + 1];
 	}
+	Alphabet alphabet;
+	if (mapOfArguments.contains("-a") && !ParseAlphabet(mapOfArguments["-a"], alphabet))
+	{
+		std::cout << std::endl << "Inappropriate argument for -a used. Aborted." << std::endl;
+		return {};
+	}
+	EntropyCoder entropyCoder;
+	if (mapOfArguments.contains("-e") && !ParseEntropyCoder(mapOfArguments["-e"], entropyCoder))
+	{
+		std::cout << std::endl << "Inappropriate argument for -e used. Aborted." << std::endl;
+		return {};
+	}
+	unsigned int number;
+	if (mapOfArguments.contains("-j") && !ParseNumberArgument(mapOfArguments["-j"], maximumNumberOfThreads, number))
+	{
+		std::cout << std::endl << "Inappropriate argument for -j used. Aborted." << std::endl;
+		return {};
+	}
+	if (mapOfArguments.contains("-b") && !(mapOfArguments["-t"] == "k" || mapOfArguments["-t"] == "d"))
+	{
+		std::cout << std::endl << "Inappropriate argument for -t used with -b. Aborted." << std::endl;
+		return {};
+	}
+	if (mapOfArguments["-t"] == "serve" || mapOfArguments["-t"] == "client")
+	{
+		if (mapOfArguments["-u"] == "")
+		{
+			std::cout << std::endl << "One of the switches is empty. Aborted" << std::endl;
+			return {};
+		}
+		if (mapOfArguments["-t"] == "serve")
+		{
+			if (mapOfArguments["-s"] == "")
+			{
+				std::cout << std::endl << "One of the switches is empty. Aborted" << std::endl;
+				return {};
+			}
+			return mapOfArguments;
+		}
+
+		const std::string& operation = mapOfArguments["-c"];
+		if (!(operation == "k" || operation == "d" || operation == "t" || operation == "q"))
+		{
+			std::cout << std::endl << "Inappropriate argument for -c used. Aborted." << std::endl;
+			return {};
+		}
+		if (mapOfArguments.contains("-n") && !ParseNumberArgument(mapOfArguments["-n"], maximumNumberOfRequests, number))
+		{
+			std::cout << std::endl << "Inappropriate argument for -n used. Aborted." << std::endl;
+			return {};
+		}
+		if (operation != "q" && (mapOfArguments["-i"] == "" || mapOfArguments["-s"] == "" || (operation != "t" && mapOfArguments["-o"] == "")))
+		{
+			std::cout << std::endl << "One of the switches is empty. Aborted" << std::endl;
+			return {};
+		}
+		return mapOfArguments;
+	}
+	if (mapOfArguments["-t"] == "b")
+	{
+		if (mapOfArguments["-i"] == "")
+		{
+			std::cout << std::endl << "One of the switches is empty. Aborted" << std::endl;
+			return {};
+		}
+		return mapOfArguments;
+	}
+	if (mapOfArguments.contains("-b"))
+	{
+		if (mapOfArguments["-b"] == "")
+		{
+			std::cout << std::endl << "One of the switches is empty. Aborted" << std::endl;
+			return {};
+		}
+		return mapOfArguments;
+	}
 	if (!mapOfArguments.contains("-t") && !mapOfArguments.contains("-i") && !mapOfArguments.contains("-o") && !mapOfArguments.contains("-s"))
 	{
 		std::cout << std::endl << "Inappropriate number of switches used. Aborted." << std::endl;
@@ -90,17 +227,27 @@ std::map<std::string, std::string> ControlForArguments (const int& numberOfArgum
 * @param fileToTakeFrom Address of the inputed file.
 * @param fileToSaveTo Address of the file where data is to be saved.
 * @param dictionaryFile Address of the file where dictionary is to be saved
+* @param alphabet Alphabet of symbols to code the file with.
+* @param entropyCoder Entropy coder to code the file with.
 */
-void Compress(const std::string& fileToTakeFrom, const std::string& fileToSaveTo, const std::string& dictionaryFile)
+void Compress(const std::string& fileToTakeFrom, const std::string& fileToSaveTo, const std::string& dictionaryFile, Alphabet alphabet, EntropyCoder entropyCoder)
 {
+	if (entropyCoder == EntropyCoder::Ans)
+	{
+		std::string inputBuffer, outputBuffer;
+		if (!CompressAns(fileToTakeFrom, fileToSaveTo, dictionaryFile, alphabet, inputBuffer, outputBuffer))
+			std::cout << std::endl << "Could not compress the file. Aborted." << std::endl;
+		return;
+	}
+	if (alphabet != Alphabet::Byte)
+	{
+		std::string inputBuffer, outputBuffer;
+		if (!CompressWide(fileToTakeFrom, fileToSaveTo, dictionaryFile, alphabet, inputBuffer, outputBuffer))
+			std::cout << std::endl << "Could not compress the file. Aborted." << std::endl;
+		return;
+	}
 	std::map<char, int> characterFrequencyMap = CreateMap(fileToTakeFrom);
-	std::vector<std::pair<int, char>> vectorToStoreFrequencyOfCharacters = CreateVector(characterFrequencyMap);
-	std::vector<std::pair<char, int>> sorterVectorOfCharsByFrequency = SortVectorMinToMax(vectorToStoreFrequencyOfCharacters);
-
-	HuffNode* pRoot = HuffmanCoding(sorterVectorOfCharsByFrequency);
-	std::map<char, std::string> tempDictionary;
-	MakeDictionary(pRoot, tempDictionary);
-	DeleteHuffEntirely(pRoot);
+	std::map<char, std::string> tempDictionary = CreateDictionary(characterFrequencyMap);
 	SaveDictionary(tempDictionary, dictionaryFile);
 
 	CompressToDiffrentFile(fileToTakeFrom, fileToSaveTo, tempDictionary);
@@ -112,18 +259,70 @@ void Compress(const std::string& fileToTakeFrom, const std::string& fileToSaveTo
 * @param fileToTakeFrom Address of the inputed file.
 * @param fileToSaveTo Address of the file where data is to be saved.
 * @param dictionaryFile Address of the file where dictionary is located
+* @param alphabet Alphabet of symbols the file has been compressed with.
+* @param entropyCoder Entropy coder the file has been compressed with.
 */
-void Decompress(const std::string& fileToTakeFrom, const std::string& fileToSaveTo, const std::string& dictionaryFile)
+void Decompress(const std::string& fileToTakeFrom, const std::string& fileToSaveTo, const std::string& dictionaryFile, Alphabet alphabet, EntropyCoder entropyCoder)
 {
+	if (entropyCoder == EntropyCoder::Ans)
+	{
+		std::string inputBuffer, outputBuffer;
+		if (!DecompressAns(fileToTakeFrom, fileToSaveTo, dictionaryFile, alphabet, inputBuffer, outputBuffer))
+			std::cout << std::endl << "Could not decompress the file, check that the dictionary matches the alphabet. Aborted." << std::endl;
+		return;
+	}
+	if (alphabet != Alphabet::Byte)
+	{
+		std::string inputBuffer, outputBuffer;
+		if (!DecompressWide(fileToTakeFrom, fileToSaveTo, dictionaryFile, alphabet, inputBuffer, outputBuffer))
+			std::cout << std::endl << "Could not decompress the file, check that the dictionary matches the alphabet. Aborted." << std::endl;
+		return;
+	}
 	std::map<char, std::string> tempDictionary = ReadDictionary(dictionaryFile);
 	DecompressToDiffrentFile(fileToTakeFrom, fileToSaveTo, tempDictionary);
 }
 
+/**
+* @brief Compresses or decompresses many files in one invocation.
+* @details Takes the jobs either from the directory or from the manifest file passed through "-b" switch,
+* runs them on the work-stealing thread pool and prints the summary.
+* @param args Map of switches assigned relevant arguments for them.
+* @return Returns 1 if all files have been processed, -1 if there were no files, some could not be processed,
+* or the manifest or the directory could not be read as a whole.
+*/
+int Batch(std::map<std::string, std::string>& args)
+{
+	bool isCompression = args["-t"] == "k";
+	unsigned int numberOfThreads = 0;
+	ParseNumberArgument(args["-j"], maximumNumberOfThreads, numberOfThreads);
+	Alphabet alphabet = Alphabet::Byte;
+	ParseAlphabet(args["-a"], alphabet);
+	EntropyCoder entropyCoder = EntropyCoder::Huffman;
+	ParseEntropyCoder(args["-e"], entropyCoder);
+
+	std::error_code errorCode;
+	std::vector<BatchJob> jobs;
+	bool isJobListWhole = std::filesystem::is_directory(args["-b"], errorCode)
+		? MakeBatchJobsFromDirectory(args["-b"], args["-o"], isCompression, jobs)
+		: ReadBatchManifest(args["-b"], jobs);
+	if (jobs.empty())
+	{
+		std::cout << std::endl << "No files to process. Aborted." << std::endl;
+		return -1;
+	}
+
+	BatchSummary summary = RunBatch(jobs, isCompression, numberOfThreads, alphabet, entropyCoder);
+	PrintBatchSummary(summary);
+	return (summary.filesFailed || !isJobListWhole) ? -1 : 1;
+}
+
 /**
 * @brief Main function of the project, receives both number of arguments and arguments from console.
 * @details This function receives arguments from console,
 * checks with usage of functions if the correct number of arguments were inputed and if there were relevant switches used.
-* It lastly checks whether the file should be compressed of decompressed and calls the appropriate function.
+* It lastly checks whether the file should be compressed of decompressed and calls the appropriate function,
+* or runs the batch mode when the switch "-b" has been used, or compares entropy coders when "-t" is "b",
+* or runs the compression service or its client when "-t" is "serve" or "client".
 * @param argc Count of arguments.
 * @param arg Arguments from console.
 * @return Returns 0 if the number of arguments is incorrect, -1 if all switches aren't presents or have arguments, 1 otherwise.
@@ -135,18 +334,40 @@ int main(int argc, char** arg)
 	std::map<std::string, std::string> args = ControlForArguments(argc, arg);
 	if (args.empty())
 		return -1;
+	if (args.contains("-b"))
+		return Batch(args);
+	if (args["-t"] == "serve")
+	{
+		unsigned int numberOfThreads = 0;
+		ParseNumberArgument(args["-j"], maximumNumberOfThreads, numberOfThreads);
+		return RunCompressionService(args["-u"], args["-s"], numberOfThreads) ? 1 : -1;
+	}
+	if (args["-t"] == "client")
+	{
+		unsigned int numberOfRequests = 1;
+		ParseNumberArgument(args["-n"], maximumNumberOfRequests, numberOfRequests);
+		return RunServiceClient(args["-u"], args["-c"][0], args["-i"], args["-o"], args["-s"], numberOfRequests) ? 1 : -1;
+	}
 	
 	std::string inFile = args["-i"];
 	std::string outFile = args["-o"];
 	std::string slownikFile = args["-s"];
+	Alphabet alphabet = Alphabet::Byte;
+	ParseAlphabet(args["-a"], alphabet);
+	EntropyCoder entropyCoder = EntropyCoder::Huffman;
+	ParseEntropyCoder(args["-e"], entropyCoder);
 	if (args["-t"] == "k")
 	{
-		Compress(inFile, outFile, slownikFile);
+		Compress(inFile, outFile, slownikFile, alphabet, entropyCoder);
 		return 1;
 	}
 	else if (args["-t"] == "d")
 	{
-		Decompress(inFile, outFile, slownikFile);
+		Decompress(inFile, outFile, slownikFile, alphabet, entropyCoder);
 		return 1;
 	}
+	else if (args["-t"] == "b")
+	{
+		return BenchmarkEntropyCoders(inFile, alphabet) ? 1 : -1;
+	}
 }
\ No newline at end of file
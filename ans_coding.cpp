@@ -0,0 +1,373 @@
+/**
+*	@file ans_coding.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the ans_coding header.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* algorithm library. */
+#include <algorithm>
+
+/* bit library. */
+#include <bit>
+
+/* cstdint library. */
+#include <cstdint>
+
+/* type_traits library. */
+#include <type_traits>
+
+/* ans_coding header file. */
+#include "ans_coding.h"
+
+/* functions_and_structs header file. */
+#include "functions_and_structs.h"
+
+/* Smallest table log used, smaller tables lose too much precision in normalized frequencies. */
+static constexpr unsigned int minimumTableLog = 11;
+
+/**
+* @brief Returns the symbol as an unsigned number, the way it is saved in the dictionary.
+*/
+template <typename Symbol>
+static unsigned long SymbolToNumber(Symbol symbol)
+{
+	return static_cast<unsigned long>(static_cast<std::make_unsigned_t<Symbol>>(symbol));
+}
+
+/**
+* @brief Spreads symbols over the slots of the table.
+* @details Every symbol takes as many slots as its normalized frequency. Slots are visited with an odd step,
+* which goes through all slots of a table whose size is a power of two, so occurrences of a symbol are scattered.
+* @param table Table of normalized frequencies.
+* @return Vector of indexes of symbols, one for every slot.
+*/
+template <typename Symbol>
+static std::vector<unsigned int> SpreadSymbols(const AnsTable<Symbol>& table)
+{
+	unsigned int tableSize = 1u << table.tableLog;
+	unsigned int mask = tableSize - 1;
+	unsigned int step = (tableSize >> 1) + (tableSize >> 3) + 3;
+
+	std::vector<unsigned int> resultSpread(tableSize, 0);
+	unsigned int position = 0;
+	for (unsigned int s = 0; s < table.symbols.size(); ++s)
+	{
+		for (unsigned int i = 0; i < table.normalizedFrequencies[s]; ++i)
+		{
+			resultSpread[position] = s;
+			position = (position + step) & mask;
+		}
+	}
+	return resultSpread;
+}
+
+/**
+* @brief Saves the tANS table to the dictionary file.
+* @return Returns true if the whole dictionary has been written, false otherwise.
+*/
+template <typename Symbol>
+static bool SaveAnsDictionary(const AnsTable<Symbol>& table, Alphabet alphabet, size_t numberOfBytes, size_t numberOfSymbols,
+	unsigned int finalState, const std::string& fileName)
+{
+	std::ofstream outStream(fileName);
+	if (!outStream)
+		return false;
+
+	outStream << "ans " << AlphabetName(alphabet) << ' ' << numberOfBytes << ' ' << numberOfSymbols << ' '
+		<< table.tableLog << ' ' << finalState << std::endl;
+	for (size_t i = 0; i < table.symbols.size(); ++i)
+	{
+		outStream << SymbolToNumber(table.symbols[i]) << ' ' << table.normalizedFrequencies[i] << std::endl;
+	}
+	outStream.close();
+	return !outStream.fail();
+}
+
+/**
+* @brief Reads the tANS table from the dictionary file.
+* @return Returns true if the file could be opened and it has been saved by tANS for the given alphabet, false otherwise.
+*/
+template <typename Symbol>
+static bool ReadAnsDictionary(const std::string& fileName, Alphabet alphabet, size_t& numberOfBytes, size_t& numberOfSymbols,
+	unsigned int& finalState, AnsTable<Symbol>& table)
+{
+	std::ifstream inFileStream(fileName);
+	if (!inFileStream)
+		return false;
+
+	std::string coderName, alphabetName;
+	if (!(inFileStream >> coderName >> alphabetName >> numberOfBytes >> numberOfSymbols >> table.tableLog >> finalState))
+		return false;
+	if (coderName != "ans" || alphabetName != AlphabetName(alphabet) || table.tableLog > 24)
+		return false;
+
+	unsigned long symbol;
+	unsigned int normalizedFrequency;
+	unsigned long long sum = 0;
+	while (inFileStream >> symbol >> normalizedFrequency)
+	{
+		table.symbols.push_back(static_cast<Symbol>(symbol));
+		table.normalizedFrequencies.push_back(normalizedFrequency);
+		sum += normalizedFrequency;
+	}
+	inFileStream.close();
+	return table.symbols.empty() ? numberOfSymbols == 0 : (sum == (1ull << table.tableLog) && finalState < sum);
+}
+
+/**
+* @brief Compresses symbols with tANS and saves the dictionary.
+*/
+template <typename Symbol>
+static bool CompressAnsWithDictionary(const std::vector<Symbol>& symbols, Alphabet alphabet, size_t numberOfBytes,
+	const std::string& dictionaryFile, std::string& outputBuffer)
+{
+	std::map<Symbol, int> frequencyMap;
+	AddSymbolsToFrequencyMap(symbols, frequencyMap);
+
+	AnsTable<Symbol> table = CreateAnsTable(frequencyMap);
+	unsigned int finalState = 0;
+	AnsCompressSymbols(symbols, table, outputBuffer, finalState);
+	return SaveAnsDictionary(table, alphabet, numberOfBytes, symbols.size(), finalState, dictionaryFile);
+}
+
+/**
+* @brief Reads the dictionary and decompresses symbols coded with tANS.
+*/
+template <typename Symbol>
+static bool DecompressAnsWithDictionary(const std::string& codes, Alphabet alphabet, const std::string& dictionaryFile,
+	size_t& numberOfBytes, std::vector<Symbol>& result)
+{
+	AnsTable<Symbol> table;
+	size_t numberOfSymbols = 0;
+	unsigned int finalState = 0;
+	if (!ReadAnsDictionary(dictionaryFile, alphabet, numberOfBytes, numberOfSymbols, finalState, table))
+		return false;
+
+	AnsDecompressSymbols(codes, numberOfSymbols, finalState, table, result);
+	return true;
+}
+
+bool ParseEntropyCoder(const std::string& name, EntropyCoder& result)
+{
+	if (name == "h")
+		result = EntropyCoder::Huffman;
+	else if (name == "ans")
+		result = EntropyCoder::Ans;
+	else
+		return false;
+	return true;
+}
+
+template <typename Symbol>
+AnsTable<Symbol> CreateAnsTable(const std::map<Symbol, int>& frequencyMap)
+{
+	AnsTable<Symbol> resultTable;
+	if (frequencyMap.empty())
+		return resultTable;
+
+	unsigned long long total = 0;
+	for (const auto& el : frequencyMap)
+	{
+		resultTable.symbols.push_back(el.first);
+		total += el.second;
+	}
+
+	resultTable.tableLog = minimumTableLog;
+	while ((1ull << resultTable.tableLog) < 2 * frequencyMap.size())
+		resultTable.tableLog++;
+	unsigned long long tableSize = 1ull << resultTable.tableLog;
+
+	unsigned long long sum = 0;
+	size_t biggest = 0;
+	for (const auto& el : frequencyMap)
+	{
+		unsigned long long scaled = (static_cast<unsigned long long>(el.second) * tableSize + total / 2) / total;
+		resultTable.normalizedFrequencies.push_back(static_cast<unsigned int>(std::max(1ull, scaled)));
+		sum += resultTable.normalizedFrequencies.back();
+		if (resultTable.normalizedFrequencies.back() > resultTable.normalizedFrequencies[biggest])
+			biggest = resultTable.normalizedFrequencies.size() - 1;
+	}
+
+	if (sum < tableSize)
+		resultTable.normalizedFrequencies[biggest] += static_cast<unsigned int>(tableSize - sum);
+	while (sum > tableSize)
+	{
+		for (unsigned int& el : resultTable.normalizedFrequencies)
+		{
+			if (sum == tableSize)
+				break;
+			if (el > 1)
+			{
+				el--;
+				sum--;
+			}
+		}
+	}
+	return resultTable;
+}
+
+template <typename Symbol>
+void AnsCompressSymbols(const std::vector<Symbol>& symbols, const AnsTable<Symbol>& table, std::string& result, unsigned int& finalState)
+{
+	finalState = 0;
+	if (symbols.empty() || table.symbols.empty())
+		return;
+
+	unsigned int tableSize = 1u << table.tableLog;
+	std::vector<unsigned int> spread = SpreadSymbols(table);
+
+	std::map<Symbol, unsigned int> symbolIndexes;
+	std::vector<unsigned int> starts(table.symbols.size(), 0);
+	for (unsigned int s = 0, start = 0; s < table.symbols.size(); ++s)
+	{
+		symbolIndexes.emplace(table.symbols[s], s);
+		starts[s] = start;
+		start += table.normalizedFrequencies[s];
+	}
+
+	std::vector<unsigned int> encodingStates(tableSize);
+	std::vector<unsigned int> taken(table.symbols.size(), 0);
+	for (unsigned int u = 0; u < tableSize; ++u)
+	{
+		unsigned int s = spread[u];
+		encodingStates[starts[s] + taken[s]++] = tableSize + u;
+	}
+
+	std::vector<std::pair<unsigned int, unsigned int>> bitChunks;
+	bitChunks.reserve(symbols.size());
+	unsigned int state = tableSize;
+	for (size_t i = symbols.size(); i-- > 0;)
+	{
+		unsigned int s = symbolIndexes.find(symbols[i])->second;
+		unsigned int frequency = table.normalizedFrequencies[s];
+		unsigned int numberOfBits = 0;
+		while ((state >> numberOfBits) >= 2 * frequency)
+			numberOfBits++;
+		bitChunks.push_back({ state & ((1u << numberOfBits) - 1), numberOfBits });
+		state = encodingStates[starts[s] + (state >> numberOfBits) - frequency];
+	}
+	finalState = state - tableSize;
+
+	for (size_t i = bitChunks.size(); i-- > 0;)
+	{
+		for (unsigned int bit = bitChunks[i].second; bit-- > 0;)
+		{
+			result += ((bitChunks[i].first >> bit) & 1) ? '1' : '0';
+		}
+	}
+}
+
+template <typename Symbol>
+void AnsDecompressSymbols(const std::string& codes, size_t numberOfSymbols, unsigned int finalState, const AnsTable<Symbol>& table, std::vector<Symbol>& result)
+{
+	if (numberOfSymbols == 0 || table.symbols.empty())
+		return;
+
+	unsigned int tableSize = 1u << table.tableLog;
+	std::vector<unsigned int> spread = SpreadSymbols(table);
+
+	std::vector<unsigned int> numberOfBits(tableSize);
+	std::vector<unsigned int> newStateBases(tableSize);
+	std::vector<unsigned int> next(table.normalizedFrequencies);
+	for (unsigned int u = 0; u < tableSize; ++u)
+	{
+		unsigned int x = next[spread[u]]++;
+		numberOfBits[u] = table.tableLog + 1 - static_cast<unsigned int>(std::bit_width(x));
+		newStateBases[u] = (x << numberOfBits[u]) - tableSize;
+	}
+
+	result.reserve(result.size() + numberOfSymbols);
+	unsigned int state = finalState;
+	size_t position = 0;
+	for (size_t i = 0; i < numberOfSymbols; ++i)
+	{
+		result.push_back(table.symbols[spread[state]]);
+		unsigned int bits = 0;
+		for (unsigned int bit = 0; bit < numberOfBits[state]; ++bit)
+		{
+			bits = (bits << 1) | ((position < codes.size() && codes[position] == '1') ? 1 : 0);
+			position++;
+		}
+		state = newStateBases[state] + bits;
+	}
+}
+
+bool CompressAns(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer)
+{
+	outputBuffer.clear();
+	if (!ReadFileToString(fromFile, inputBuffer, true))
+		return false;
+
+	bool isSaved = false;
+	if (alphabet == Alphabet::Byte)
+		isSaved = CompressAnsWithDictionary(std::vector<char>(inputBuffer.begin(), inputBuffer.end()), alphabet, inputBuffer.size(), dictionaryFile, outputBuffer);
+	else if (alphabet == Alphabet::Word16)
+		isSaved = CompressAnsWithDictionary(MakeWord16Symbols(inputBuffer), alphabet, inputBuffer.size(), dictionaryFile, outputBuffer);
+	else if (alphabet == Alphabet::Digram)
+		isSaved = CompressAnsWithDictionary(MakeDigramSymbols(inputBuffer), alphabet, inputBuffer.size(), dictionaryFile, outputBuffer);
+	if (!isSaved)
+		return false;
+
+	std::ofstream toFileStream(toFile);
+	if (!toFileStream)
+		return false;
+	toFileStream.write(outputBuffer.data(), outputBuffer.size());
+	toFileStream.close();
+	return !toFileStream.fail();
+}
+
+bool DecompressAns(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer)
+{
+	outputBuffer.clear();
+	if (!ReadFileToString(fromFile, inputBuffer))
+		return false;
+
+	size_t numberOfBytes = 0;
+	if (alphabet == Alphabet::Byte)
+	{
+		std::vector<char> symbols;
+		if (!DecompressAnsWithDictionary(inputBuffer, alphabet, dictionaryFile, numberOfBytes, symbols))
+			return false;
+		outputBuffer.assign(symbols.begin(), symbols.end());
+	}
+	else if (alphabet == Alphabet::Word16)
+	{
+		std::vector<uint16_t> symbols;
+		if (!DecompressAnsWithDictionary(inputBuffer, alphabet, dictionaryFile, numberOfBytes, symbols))
+			return false;
+		outputBuffer = ExpandWord16Symbols(symbols, numberOfBytes);
+	}
+	else if (alphabet == Alphabet::Digram)
+	{
+		std::vector<uint32_t> symbols;
+		if (!DecompressAnsWithDictionary(inputBuffer, alphabet, dictionaryFile, numberOfBytes, symbols))
+			return false;
+		outputBuffer = ExpandDigramSymbols(symbols);
+	}
+
+	std::ofstream toFileStream(toFile, std::ios::out | std::ios::binary);
+	if (!toFileStream)
+		return false;
+	toFileStream.write(outputBuffer.data(), outputBuffer.size());
+	toFileStream.close();
+	return !toFileStream.fail();
+}
+
+/* -- Explicit instantiations for the supported symbol types -- */
+
+#define INSTANTIATE_ANS_FUNCTIONS(Symbol) \
+	template AnsTable<Symbol> CreateAnsTable(const std::map<Symbol, int>& frequencyMap); \
+	template void AnsCompressSymbols(const std::vector<Symbol>& symbols, const AnsTable<Symbol>& table, std::string& result, unsigned int& finalState); \
+	template void AnsDecompressSymbols(const std::string& codes, size_t numberOfSymbols, unsigned int finalState, const AnsTable<Symbol>& table, std::vector<Symbol>& result);
+
+INSTANTIATE_ANS_FUNCTIONS(char)
+INSTANTIATE_ANS_FUNCTIONS(uint16_t)
+INSTANTIATE_ANS_FUNCTIONS(uint32_t)
+
+#undef INSTANTIATE_ANS_FUNCTIONS
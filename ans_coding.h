@@ -0,0 +1,129 @@
+/**
+*	@file ans_coding.h
+*	@brief Structures and declaration of functions for the table-based asymmetric numeral systems (tANS) coder.
+*	@details Contains the EntropyCoder enumeration used to choose between huffman's coding and tANS, the AnsTable structure
+*	and declarations of functions which build the table from the same frequency map huffman's coding uses and code symbols with it.
+*	tANS does not round code lengths to whole bits, so it wastes less than huffman's coding on skewed distributions.
+*	Coded data is saved the same way as huffman's codes, as a string of '0' and '1'. The dictionary file starts with the line
+*	"ans <alphabet> <size of the original file> <number of symbols> <table log> <final state>", followed by lines of a symbol
+*	(written as a number), a space, and its normalized frequency.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef ans_coding_h
+#define ans_coding_h
+
+/* -- Includes -- */
+
+/* map library. */
+#include <map>
+
+/* string library. */
+#include <string>
+
+/* vector library. */
+#include <vector>
+
+/* wide_alphabet header file. */
+#include "wide_alphabet.h"
+
+/**
+* @brief Entropy coder the file is coded with.
+*/
+enum class EntropyCoder
+{
+	Huffman,	//!< Huffman's coding, the original coder.
+	Ans			//!< Table-based asymmetric numeral systems.
+};
+
+/**
+* @brief Table of normalized frequencies from which tANS coding and decoding tables are built.
+* @tparam Symbol Type of the coded symbol.
+*/
+template <typename Symbol>
+struct AnsTable
+{
+/**
+* @brief Binary logarithm of the size of the table, the sum of normalized frequencies equals 2 to the power of it.
+*/
+	unsigned int tableLog = 0;
+
+/**
+* @brief Symbols present in the data, sorted.
+*/
+	std::vector<Symbol> symbols;
+
+/**
+* @brief Normalized frequency of every symbol, at least one for each.
+*/
+	std::vector<unsigned int> normalizedFrequencies;
+};
+
+/**
+* @brief Reads the entropy coder from the argument of the "-e" switch.
+* @param name Argument of the switch, "h" or "ans".
+* @param result Entropy coder read from the argument, passed as a reference.
+* @return Returns true if the argument names an entropy coder, false otherwise.
+*/
+bool ParseEntropyCoder(const std::string& name, EntropyCoder& result);
+
+/**
+* @brief Makes the tANS table from the frequency map.
+* @details The table log is at least 11 and big enough for the table to have at least two slots per symbol.
+* Frequencies are scaled so they sum up to the size of the table, every symbol keeps at least one slot.
+* @param frequencyMap Frequency map of symbols.
+* @return Table of normalized frequencies, empty if the frequency map is empty.
+*/
+template <typename Symbol>
+AnsTable<Symbol> CreateAnsTable(const std::map<Symbol, int>& frequencyMap);
+
+/**
+* @brief Compresses symbols with tANS and appends the result to the string.
+* @details Symbols are coded from the last one to the first one, so the decoder can read them in order.
+* @param symbols Symbols to compress, every one of them has to be present in the table.
+* @param table Table of normalized frequencies.
+* @param result String to which codes are appended, passed as a reference.
+* @param finalState State of the coder after the last coded symbol, needed to start decoding, passed as a reference.
+*/
+template <typename Symbol>
+void AnsCompressSymbols(const std::vector<Symbol>& symbols, const AnsTable<Symbol>& table, std::string& result, unsigned int& finalState);
+
+/**
+* @brief Decompresses symbols coded with tANS and appends them to the vector.
+* @param codes String of codes.
+* @param numberOfSymbols Number of symbols to decode.
+* @param finalState State of the coder saved by AnsCompressSymbols.
+* @param table Table of normalized frequencies.
+* @param result Vector to which symbols are appended, passed as a reference.
+*/
+template <typename Symbol>
+void AnsDecompressSymbols(const std::string& codes, size_t numberOfSymbols, unsigned int finalState, const AnsTable<Symbol>& table, std::vector<Symbol>& result);
+
+/**
+* @brief Compresses the file with tANS, saves compressed data to out-file and creates a dictionary.
+* @details The file is read in binary mode with every alphabet, including Alphabet::Byte.
+* @param fromFile Address of the inputed file.
+* @param toFile Address of the file where data is to be saved.
+* @param dictionaryFile Address of the file where dictionary is to be saved.
+* @param alphabet Alphabet of symbols to code the file with.
+* @param inputBuffer Scratch string for the content of the inputed file, passed as a reference so it can be reused.
+* @param outputBuffer Scratch string for the compressed data, passed as a reference so it can be reused.
+* @return Returns true if the files could be opened and the output file and the dictionary have been written, false otherwise.
+*/
+bool CompressAns(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer);
+
+/**
+* @brief Decompresses the file compressed with tANS with the use of its dictionary.
+* @param fromFile Address of the inputed file.
+* @param toFile Address of the file where data is to be saved.
+* @param dictionaryFile Address of the file where the dictionary is located.
+* @param alphabet Alphabet the file has been compressed with, it has to match the one saved in the dictionary.
+* @param inputBuffer Scratch string for the content of the inputed file, passed as a reference so it can be reused.
+* @param outputBuffer Scratch string for the decompressed data, passed as a reference so it can be reused.
+* @return Returns true if the files could be opened, the dictionary matches the alphabet and the output file has been written, false otherwise.
+*/
+bool DecompressAns(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer);
+#endif
@@ -0,0 +1,493 @@
+/**
+*	@file batch_mode.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the batch_mode header together with the codec contexts
+*	and helper functions used only by the batch mode.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* algorithm library. */
+#include <algorithm>
+
+/* atomic library. */
+#include <atomic>
+
+/* chrono library. */
+#include <chrono>
+
+/* exception library. */
+#include <exception>
+
+/* filesystem library. */
+#include <filesystem>
+
+/* sstream library. */
+#include <sstream>
+
+/* batch_mode header file. */
+#include "batch_mode.h"
+
+/* functions_and_structs header file. */
+#include "functions_and_structs.h"
+
+/* thread_pool header file. */
+#include "thread_pool.h"
+
+/* Files bigger than this are split into blocks of this size that are coded in parallel. */
+static constexpr size_t blockSize = 1 << 20;
+
+/* Files smaller than this are grouped together into a single task. */
+static constexpr unsigned long long smallFileSize = 64 << 10;
+
+/* Grouping of small files stops once the group reaches this many bytes or files. */
+static constexpr unsigned long long smallFileGroupBytes = 1 << 20;
+static constexpr size_t smallFileGroupFiles = 64;
+
+/**
+* @brief Buffers used during coding of a single file, kept between jobs so their memory is reused.
+*/
+struct CodecContext
+{
+/**
+* @brief Content of the inputed file.
+*/
+	std::string inputBuffer;
+
+/**
+* @brief Compressed or decompressed content of a file coded as a whole.
+*/
+	std::string outputBuffer;
+
+/**
+* @brief Coded content of every block of the inputed file.
+*/
+	std::vector<std::string> blockBuffers;
+
+/**
+* @brief Frequency maps of every block of the inputed file.
+*/
+	std::vector<std::map<char, int>> blockFrequencyMaps;
+};
+
+/**
+* @brief Pool of codec contexts which are not in use at the moment.
+* @details A job takes a context when it starts and gives it back when it ends. New contexts are only made
+* when all existing ones are in use, so there are never more of them than jobs running at the same time.
+*/
+struct CodecContextPool
+{
+	std::mutex mutex;
+	std::vector<std::unique_ptr<CodecContext>> freeContexts;
+
+	std::unique_ptr<CodecContext> Acquire()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (freeContexts.empty())
+			return std::make_unique<CodecContext>();
+		std::unique_ptr<CodecContext> context = std::move(freeContexts.back());
+		freeContexts.pop_back();
+		return context;
+	}
+
+	void Release(std::unique_ptr<CodecContext> context)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		freeContexts.push_back(std::move(context));
+	}
+};
+
+/**
+* @brief State shared by all jobs of the batch.
+*/
+struct BatchState
+{
+	WorkStealingPool& pool;
+	bool isCompression;
+	Alphabet alphabet;
+	EntropyCoder entropyCoder;
+	CodecContextPool contexts;
+	std::atomic<size_t> filesProcessed{ 0 };
+	std::atomic<size_t> filesFailed{ 0 };
+	std::atomic<unsigned long long> bytesRead{ 0 };
+	std::atomic<unsigned long long> bytesWritten{ 0 };
+
+	BatchState(WorkStealingPool& workPool, bool compression, Alphabet jobAlphabet, EntropyCoder jobEntropyCoder)
+		: pool(workPool), isCompression(compression), alphabet(jobAlphabet), entropyCoder(jobEntropyCoder) {}
+};
+
+/**
+* @brief Splits the text into blocks of roughly the given size.
+* @details When alignToLines is set every block ends right after a new line character (or at the end of the text),
+* which is needed by decompression since codes never go over the new line character.
+* @param text Text to split.
+* @param alignToLines Whether blocks have to end on the line boundary.
+* @return Vector of pairs of the beginning and the end of every block, at least one block even for an empty text.
+*/
+static std::vector<std::pair<size_t, size_t>> SplitIntoBlocks(const std::string& text, bool alignToLines)
+{
+	std::vector<std::pair<size_t, size_t>> resultBlocks;
+	size_t begin = 0;
+	while (text.size() - begin > blockSize)
+	{
+		size_t end = begin + blockSize;
+		if (alignToLines)
+		{
+			end = text.find('\n', end);
+			if (end == std::string::npos)
+				break;
+			++end;
+		}
+		resultBlocks.push_back({ begin, end });
+		begin = end;
+	}
+	resultBlocks.push_back({ begin, text.size() });
+	return resultBlocks;
+}
+
+/**
+* @brief Runs the function for every block, in parallel on the pool when there is more than one block.
+* @param state State of the batch.
+* @param numberOfBlocks Number of blocks.
+* @param function Function taking the index of the block.
+*/
+static void ForEachBlock(BatchState& state, size_t numberOfBlocks, const std::function<void(size_t)>& function)
+{
+	if (numberOfBlocks == 1)
+	{
+		function(0);
+		return;
+	}
+	TaskGroup blockTasks;
+	for (size_t i = 0; i < numberOfBlocks; ++i)
+	{
+		state.pool.Submit([&function, i]() { function(i); }, blockTasks);
+	}
+	state.pool.WaitFor(blockTasks);
+}
+
+/**
+* @brief Compresses or decompresses a single file as a whole, with tANS or with a wide alphabet.
+* @param job Files of the job.
+* @param state State of the batch.
+* @param context Codec context whose buffers are used.
+* @return Returns true if the file has been coded and both output files written, false otherwise.
+*/
+static bool RunWholeFileJob(const BatchJob& job, BatchState& state, CodecContext& context)
+{
+	bool isDone = false;
+	if (state.entropyCoder == EntropyCoder::Ans)
+		isDone = state.isCompression
+			? CompressAns(job.inputFile, job.outputFile, job.dictionaryFile, state.alphabet, context.inputBuffer, context.outputBuffer)
+			: DecompressAns(job.inputFile, job.outputFile, job.dictionaryFile, state.alphabet, context.inputBuffer, context.outputBuffer);
+	else
+		isDone = state.isCompression
+			? CompressWide(job.inputFile, job.outputFile, job.dictionaryFile, state.alphabet, context.inputBuffer, context.outputBuffer)
+			: DecompressWide(job.inputFile, job.outputFile, job.dictionaryFile, state.alphabet, context.inputBuffer, context.outputBuffer);
+	if (!isDone)
+	{
+		std::cout << std::endl << "Could not process \"" << job.inputFile << "\"." << std::endl;
+		return false;
+	}
+	state.bytesRead += context.inputBuffer.size();
+	state.bytesWritten += context.outputBuffer.size();
+	return true;
+}
+
+/**
+* @brief Compresses or decompresses a single file with huffman's coding and the character alphabet, block by block.
+* @param job Files of the job.
+* @param state State of the batch.
+* @param context Codec context whose buffers are used.
+* @return Returns true if the file has been coded and both output files written, false otherwise.
+*/
+static bool RunBlockJob(const BatchJob& job, BatchState& state, CodecContext& context)
+{
+	std::string& text = context.inputBuffer;
+	if (!ReadFileToString(job.inputFile, text))
+	{
+		std::cout << std::endl << "Could not open \"" << job.inputFile << "\"." << std::endl;
+		return false;
+	}
+
+	std::vector<std::pair<size_t, size_t>> blocks = SplitIntoBlocks(text, !state.isCompression);
+	context.blockBuffers.resize(std::max(context.blockBuffers.size(), blocks.size()));
+	for (size_t i = 0; i < blocks.size(); ++i)
+	{
+		context.blockBuffers[i].clear();
+	}
+
+	if (state.isCompression)
+	{
+		context.blockFrequencyMaps.resize(std::max(context.blockFrequencyMaps.size(), blocks.size()));
+		ForEachBlock(state, blocks.size(), [&](size_t i)
+			{
+				context.blockFrequencyMaps[i].clear();
+				AddToFrequencyMap(text.data() + blocks[i].first, text.data() + blocks[i].second, context.blockFrequencyMaps[i]);
+			});
+
+		std::map<char, int> frequencyMap;
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			for (const auto& el : context.blockFrequencyMaps[i])
+			{
+				frequencyMap[el.first] += el.second;
+			}
+		}
+
+		std::map<char, std::string> dictionary;
+		if (!frequencyMap.empty())
+			dictionary = CreateDictionary(frequencyMap);
+		if (!SaveDictionary(dictionary, job.dictionaryFile))
+		{
+			std::cout << std::endl << "Could not save the dictionary \"" << job.dictionaryFile << "\"." << std::endl;
+			return false;
+		}
+
+		ForEachBlock(state, blocks.size(), [&](size_t i)
+			{
+				CompressText(text.data() + blocks[i].first, text.data() + blocks[i].second, dictionary, context.blockBuffers[i]);
+			});
+	}
+	else
+	{
+		std::map<char, std::string> dictionary = ReadDictionary(job.dictionaryFile);
+		if (dictionary.empty() && text.find_first_not_of('\n') != std::string::npos)
+		{
+			std::cout << std::endl << "Could not read the dictionary \"" << job.dictionaryFile << "\"." << std::endl;
+			return false;
+		}
+		std::map<std::string, char> reversedDictionary = ReverseDictionary(dictionary);
+
+		ForEachBlock(state, blocks.size(), [&](size_t i)
+			{
+				DecompressText(text.data() + blocks[i].first, text.data() + blocks[i].second, reversedDictionary, context.blockBuffers[i]);
+			});
+	}
+
+	std::ofstream outFileStream(job.outputFile);
+	if (!outFileStream)
+	{
+		std::cout << std::endl << "Could not open \"" << job.outputFile << "\"." << std::endl;
+		return false;
+	}
+	unsigned long long bytesWritten = 0;
+	for (size_t i = 0; i < blocks.size(); ++i)
+	{
+		outFileStream.write(context.blockBuffers[i].data(), context.blockBuffers[i].size());
+		bytesWritten += context.blockBuffers[i].size();
+	}
+	outFileStream.close();
+	if (outFileStream.fail())
+	{
+		std::cout << std::endl << "Could not write \"" << job.outputFile << "\"." << std::endl;
+		return false;
+	}
+
+	state.bytesRead += text.size();
+	state.bytesWritten += bytesWritten;
+	return true;
+}
+
+/**
+* @brief Compresses or decompresses a single file and counts it as processed or failed.
+* @details Exceptions are caught here, so a file that has thrown is counted as failed and its codec context is returned to the pool.
+* @param job Files of the job.
+* @param state State of the batch.
+*/
+static void RunJob(const BatchJob& job, BatchState& state)
+{
+	std::unique_ptr<CodecContext> context = state.contexts.Acquire();
+	bool isDone = false;
+	try
+	{
+		isDone = (state.alphabet != Alphabet::Byte || state.entropyCoder != EntropyCoder::Huffman)
+			? RunWholeFileJob(job, state, *context)
+			: RunBlockJob(job, state, *context);
+	}
+	catch (const std::exception& exception)
+	{
+		std::cout << std::endl << "Could not process \"" << job.inputFile << "\": " << exception.what() << std::endl;
+	}
+	catch (...)
+	{
+		std::cout << std::endl << "Could not process \"" << job.inputFile << "\"." << std::endl;
+	}
+
+	if (isDone)
+		state.filesProcessed++;
+	else
+		state.filesFailed++;
+	state.contexts.Release(std::move(context));
+}
+
+bool ReadBatchManifest(const std::string& manifestFile, std::vector<BatchJob>& resultJobs)
+{
+	std::ifstream inFileStream(manifestFile);
+	if (!inFileStream)
+	{
+		std::cout << std::endl << "Could not open the manifest \"" << manifestFile << "\"." << std::endl;
+		return false;
+	}
+
+	bool isWhole = true;
+	{
+		std::string temp;
+		while (std::getline(inFileStream, temp))
+		{
+			if (!temp.empty() && temp.back() == '\r')
+				temp.pop_back();
+			if (temp.empty())
+				continue;
+
+			std::vector<std::string> fields;
+			if (temp.find('\t') != std::string::npos)
+			{
+				std::stringstream lineStream(temp);
+				std::string field;
+				while (std::getline(lineStream, field, '\t'))
+				{
+					fields.push_back(field);
+				}
+			}
+			else
+			{
+				std::stringstream lineStream(temp);
+				std::string field;
+				while (lineStream >> field)
+				{
+					fields.push_back(field);
+				}
+			}
+
+			if (fields.size() != 3)
+			{
+				std::cout << std::endl << "Inappropriate line in manifest: \"" << temp << "\". Skipped." << std::endl;
+				isWhole = false;
+				continue;
+			}
+			resultJobs.push_back({ fields[0], fields[1], fields[2] });
+		}
+		if (inFileStream.bad())
+		{
+			std::cout << std::endl << "Could not read the whole manifest \"" << manifestFile << "\"." << std::endl;
+			isWhole = false;
+		}
+		inFileStream.close();
+	}
+	return isWhole;
+}
+
+bool MakeBatchJobsFromDirectory(const std::string& directory, const std::string& outputDirectory, bool isCompression,
+	std::vector<BatchJob>& resultJobs)
+{
+	std::error_code errorCode;
+
+	std::filesystem::path outPath = outputDirectory.empty() ? std::filesystem::path(directory) : std::filesystem::path(outputDirectory);
+	std::filesystem::create_directories(outPath, errorCode);
+
+	std::error_code iterationErrorCode;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, iterationErrorCode))
+	{
+		if (!entry.is_regular_file(errorCode))
+			continue;
+
+		std::filesystem::path inPath = entry.path();
+		std::string extension = inPath.extension().string();
+		if (isCompression)
+		{
+			if (extension == ".huf" || extension == ".dic")
+				continue;
+			std::string name = inPath.filename().string();
+			resultJobs.push_back({ inPath.string(), (outPath / (name + ".huf")).string(), (outPath / (name + ".dic")).string() });
+		}
+		else
+		{
+			if (extension != ".huf")
+				continue;
+			std::filesystem::path stem = inPath.stem();
+			resultJobs.push_back({ inPath.string(), (outPath / stem).string(), (inPath.parent_path() / (stem.string() + ".dic")).string() });
+		}
+	}
+
+	std::sort(resultJobs.begin(), resultJobs.end(), [](const BatchJob& left, const BatchJob& right)
+		{
+			return left.inputFile < right.inputFile;
+		});
+	if (iterationErrorCode)
+	{
+		std::cout << std::endl << "Could not read the directory \"" << directory << "\"." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+BatchSummary RunBatch(const std::vector<BatchJob>& jobs, bool isCompression, unsigned int numberOfThreads,
+	Alphabet alphabet, EntropyCoder entropyCoder)
+{
+	auto start = std::chrono::steady_clock::now();
+	if (numberOfThreads == 0)
+		numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	BatchSummary summary;
+	{
+		WorkStealingPool pool(numberOfThreads);
+		BatchState state(pool, isCompression, alphabet, entropyCoder);
+		TaskGroup jobTasks;
+
+		std::vector<const BatchJob*> smallFileGroup;
+		unsigned long long smallFileGroupSize = 0;
+		auto submitSmallFileGroup = [&]()
+		{
+			if (smallFileGroup.empty())
+				return;
+			pool.Submit([group = std::move(smallFileGroup), &state]()
+				{
+					for (const BatchJob* job : group)
+					{
+						RunJob(*job, state);
+					}
+				}, jobTasks);
+			smallFileGroup.clear();
+			smallFileGroupSize = 0;
+		};
+
+		for (const BatchJob& job : jobs)
+		{
+			std::error_code errorCode;
+			unsigned long long fileSize = std::filesystem::file_size(job.inputFile, errorCode);
+			if (errorCode || fileSize >= smallFileSize)
+			{
+				pool.Submit([&job, &state]() { RunJob(job, state); }, jobTasks);
+				continue;
+			}
+			smallFileGroup.push_back(&job);
+			smallFileGroupSize += fileSize;
+			if (smallFileGroupSize >= smallFileGroupBytes || smallFileGroup.size() >= smallFileGroupFiles)
+				submitSmallFileGroup();
+		}
+		submitSmallFileGroup();
+		pool.WaitFor(jobTasks);
+
+		summary.filesProcessed = state.filesProcessed;
+		summary.filesFailed = state.filesFailed;
+		summary.bytesRead = state.bytesRead;
+		summary.bytesWritten = state.bytesWritten;
+		summary.numberOfThreads = pool.NumberOfWorkers();
+	}
+	summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return summary;
+}
+
+void PrintBatchSummary(const BatchSummary& summary)
+{
+	std::cout << std::endl << "Batch finished." << std::endl;
+	std::cout << "Files processed: " << summary.filesProcessed << std::endl;
+	std::cout << "Files failed:    " << summary.filesFailed << std::endl;
+	std::cout << "Bytes read:      " << summary.bytesRead << std::endl;
+	std::cout << "Bytes written:   " << summary.bytesWritten << std::endl;
+	std::cout << "Threads:         " << summary.numberOfThreads << std::endl;
+	std::cout << "Time:            " << summary.seconds << " s" << std::endl;
+}
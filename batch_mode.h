@@ -0,0 +1,130 @@
+/**
+*	@file batch_mode.h
+*	@brief Structures and declaration of functions for compressing and decompressing many files in one invocation.
+*	@details Contains the BatchJob and BatchSummary structures and declarations of functions which read the list of jobs
+*	from a manifest or a directory and run them on the work-stealing thread pool.
+*	Large files are split into blocks that are coded in parallel, small files are grouped into a single task,
+*	and buffers used for coding are kept in a pool of codec contexts reused between jobs.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef batch_mode_h
+#define batch_mode_h
+
+/* -- Includes -- */
+
+/* string library. */
+#include <string>
+
+/* vector library. */
+#include <vector>
+
+/* wide_alphabet header file. */
+#include "wide_alphabet.h"
+
+/* ans_coding header file. */
+#include "ans_coding.h"
+
+/**
+* @brief Files of a single compression or decompression.
+*/
+struct BatchJob
+{
+/**
+* @brief Address of the inputed file.
+*/
+	std::string inputFile;
+
+/**
+* @brief Address of the file where data is to be saved.
+*/
+	std::string outputFile;
+
+/**
+* @brief Address of the dictionary file.
+*/
+	std::string dictionaryFile;
+};
+
+/**
+* @brief Summary of the batch reported once all jobs have finished.
+*/
+struct BatchSummary
+{
+/**
+* @brief Number of jobs that have finished successfully.
+*/
+	size_t filesProcessed = 0;
+
+/**
+* @brief Number of jobs that have failed, because a file could not be opened, read or written,
+* the dictionary could not be read or saved, or coding the file has thrown an exception.
+*/
+	size_t filesFailed = 0;
+
+/**
+* @brief Number of bytes read from the inputed files.
+*/
+	unsigned long long bytesRead = 0;
+
+/**
+* @brief Number of bytes written to the output files.
+*/
+	unsigned long long bytesWritten = 0;
+
+/**
+* @brief Number of threads that have been used.
+*/
+	unsigned int numberOfThreads = 0;
+
+/**
+* @brief Time the whole batch has taken, in seconds.
+*/
+	double seconds = 0.0;
+};
+
+/**
+* @brief Reads jobs from the manifest file.
+* @details Every non empty line of the manifest consists of the inputed file, the output file and the dictionary file
+* separated with tabulators, or with spaces if there is no tabulator in the line.
+* Lines that are not made of three fields are skipped, jobs of the remaining lines are still added.
+* @param manifestFile Address of the manifest file.
+* @param resultJobs Vector to which the jobs are added, passed as a reference.
+* @return Returns true if the manifest has been opened and no line has been skipped, false otherwise.
+*/
+bool ReadBatchManifest(const std::string& manifestFile, std::vector<BatchJob>& resultJobs);
+
+/**
+* @brief Makes jobs for every regular file in the directory.
+* @details When compressing, every file "name" gives the output "name.huf" and the dictionary "name.dic".
+* When decompressing, every file "name.huf" is decompressed to "name" with the dictionary "name.dic" lying next to it.
+* @param directory Address of the directory with the inputed files.
+* @param outputDirectory Address of the directory where output files and dictionaries are to be saved,
+* if empty they are saved next to the inputed files.
+* @param isCompression True if the files are to be compressed, false if decompressed.
+* @param resultJobs Vector to which the jobs are added, sorted by the name of the inputed file, passed as a reference.
+* @return Returns true if the whole directory has been read, false otherwise.
+*/
+bool MakeBatchJobsFromDirectory(const std::string& directory, const std::string& outputDirectory, bool isCompression,
+	std::vector<BatchJob>& resultJobs);
+
+/**
+* @brief Runs all jobs on the work-stealing thread pool.
+* @param jobs Jobs to run.
+* @param isCompression True if the files are to be compressed, false if decompressed.
+* @param numberOfThreads Number of workers of the pool, 0 means the number of hardware threads.
+* @param alphabet Alphabet of symbols to code the files with.
+* @param entropyCoder Entropy coder to code the files with.
+* Only files coded with huffman's coding and Alphabet::Byte are split into blocks, others are coded as a whole.
+* @return Summary of the batch.
+*/
+BatchSummary RunBatch(const std::vector<BatchJob>& jobs, bool isCompression, unsigned int numberOfThreads,
+	Alphabet alphabet = Alphabet::Byte, EntropyCoder entropyCoder = EntropyCoder::Huffman);
+
+/**
+* @brief Prints the summary of the batch on the console.
+* @param summary Summary to print.
+*/
+void PrintBatchSummary(const BatchSummary& summary);
+#endif
@@ -0,0 +1,114 @@
+/**
+*	@file benchmark.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the benchmark header.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* chrono library. */
+#include <chrono>
+
+/* cmath library. */
+#include <cmath>
+
+/* iomanip library. */
+#include <iomanip>
+
+/* benchmark header file. */
+#include "benchmark.h"
+
+/* ans_coding header file. */
+#include "ans_coding.h"
+
+/* functions_and_structs header file. */
+#include "functions_and_structs.h"
+
+/**
+* @brief Returns the number of milliseconds that have passed since start.
+*/
+static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+* @brief Prints a single row of the results.
+*/
+static void PrintBenchmarkRow(const std::string& name, double bits, size_t numberOfSymbols, double compressMs, double decompressMs, const std::string& roundTrip)
+{
+	std::cout << std::left << std::setw(10) << name << std::right
+		<< std::setw(14) << std::fixed << std::setprecision(0) << bits
+		<< std::setw(14) << std::setprecision(4) << (numberOfSymbols ? bits / numberOfSymbols : 0.0)
+		<< std::setw(14) << std::setprecision(2) << compressMs
+		<< std::setw(16) << decompressMs
+		<< std::setw(12) << roundTrip << std::endl;
+}
+
+/**
+* @brief Codes the symbols with both coders and prints the results.
+*/
+template <typename Symbol>
+static bool BenchmarkSymbols(const std::vector<Symbol>& symbols)
+{
+	std::map<Symbol, int> frequencyMap;
+	AddSymbolsToFrequencyMap(symbols, frequencyMap);
+
+	double entropyBits = 0.0;
+	for (const auto& el : frequencyMap)
+	{
+		double probability = static_cast<double>(el.second) / symbols.size();
+		entropyBits -= el.second * std::log2(probability);
+	}
+
+	std::cout << std::endl << "Symbols: " << symbols.size() << ", distinct: " << frequencyMap.size() << std::endl;
+	std::cout << std::left << std::setw(10) << "Coder" << std::right << std::setw(14) << "Bits" << std::setw(14) << "Bits/symbol"
+		<< std::setw(14) << "Compress ms" << std::setw(16) << "Decompress ms" << std::setw(12) << "Round trip" << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	std::string huffmanCodes;
+	std::map<Symbol, std::string> dictionary;
+	if (!frequencyMap.empty())
+		dictionary = CreateDictionary(frequencyMap);
+	CompressSymbols(symbols, dictionary, huffmanCodes);
+	double huffmanCompressMs = MillisecondsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	std::vector<Symbol> huffmanSymbols;
+	DecompressSymbols(huffmanCodes, ReverseDictionary(dictionary), huffmanSymbols);
+	double huffmanDecompressMs = MillisecondsSince(start);
+	bool isHuffmanCorrect = huffmanSymbols == symbols;
+
+	start = std::chrono::steady_clock::now();
+	std::string ansCodes;
+	unsigned int finalState = 0;
+	AnsTable<Symbol> table = CreateAnsTable(frequencyMap);
+	AnsCompressSymbols(symbols, table, ansCodes, finalState);
+	double ansCompressMs = MillisecondsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	std::vector<Symbol> ansSymbols;
+	AnsDecompressSymbols(ansCodes, symbols.size(), finalState, table, ansSymbols);
+	double ansDecompressMs = MillisecondsSince(start);
+	bool isAnsCorrect = ansSymbols == symbols;
+
+	PrintBenchmarkRow("Huffman", static_cast<double>(huffmanCodes.size()), symbols.size(), huffmanCompressMs, huffmanDecompressMs, isHuffmanCorrect ? "ok" : "FAILED");
+	PrintBenchmarkRow("tANS", static_cast<double>(ansCodes.size()), symbols.size(), ansCompressMs, ansDecompressMs, isAnsCorrect ? "ok" : "FAILED");
+	PrintBenchmarkRow("Entropy", entropyBits, symbols.size(), 0.0, 0.0, "-");
+	return isHuffmanCorrect && isAnsCorrect;
+}
+
+bool BenchmarkEntropyCoders(const std::string& fileName, Alphabet alphabet)
+{
+	std::string data;
+	if (!ReadFileToString(fileName, data, true))
+		return false;
+
+	if (alphabet == Alphabet::Word16)
+		return BenchmarkSymbols(MakeWord16Symbols(data));
+	if (alphabet == Alphabet::Digram)
+		return BenchmarkSymbols(MakeDigramSymbols(data));
+	return BenchmarkSymbols(std::vector<char>(data.begin(), data.end()));
+}
@@ -0,0 +1,30 @@
+/**
+*	@file benchmark.h
+*	@brief Declaration of the function comparing entropy coders.
+*	@details Contains the declaration of the function which codes a single file in memory with huffman's coding and with tANS
+*	and prints sizes and times of both, next to the entropy of the file, which is the bound neither coder can go below.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef benchmark_h
+#define benchmark_h
+
+/* -- Includes -- */
+
+/* string library. */
+#include <string>
+
+/* wide_alphabet header file. */
+#include "wide_alphabet.h"
+
+/**
+* @brief Compares huffman's coding and tANS on the file and prints the results on the console.
+* @details The file is read in binary mode and turned into symbols of the given alphabet. Both coders get the same
+* frequency map, compress the symbols, decompress them back and check that the result matches.
+* @param fileName Address of the inputed file.
+* @param alphabet Alphabet of symbols to code the file with.
+* @return Returns true if the file could be opened and both coders decompressed the original symbols, false otherwise.
+*/
+bool BenchmarkEntropyCoders(const std::string& fileName, Alphabet alphabet);
+#endif
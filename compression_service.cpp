@@ -0,0 +1,550 @@
+/**
+*	@file compression_service.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the compression_service header together with the dictionary cache
+*	and the handling of single connections and requests.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* algorithm library. */
+#include <algorithm>
+
+/* array library. */
+#include <array>
+
+/* atomic library. */
+#include <atomic>
+
+/* chrono library. */
+#include <chrono>
+
+/* condition_variable library. */
+#include <condition_variable>
+
+/* deque library. */
+#include <deque>
+
+/* exception library. */
+#include <exception>
+
+/* filesystem library. */
+#include <filesystem>
+
+/* list library. */
+#include <list>
+
+/* compression_service header file. */
+#include "compression_service.h"
+
+/* service_protocol header file. */
+#include "service_protocol.h"
+
+/* functions_and_structs header file. */
+#include "functions_and_structs.h"
+
+/* thread_pool header file. */
+#include "thread_pool.h"
+
+/* Longest pause between attempts to accept a connection after accepting has failed for a reason that may pass. */
+static constexpr std::chrono::milliseconds maximumAcceptBackoff(1000);
+
+/**
+* @brief Dictionary kept loaded by the service.
+*/
+struct CachedDictionary
+{
+/**
+* @brief Map with characters as keys and their codes as values.
+*/
+	std::map<char, std::string> dictionary;
+
+/**
+* @brief Map with codes as keys and their characters as values.
+*/
+	std::map<std::string, char> reversedDictionary;
+
+/**
+* @brief Length of the code of the character, 0 if it has none, used to refuse data the dictionary cannot compress
+* and to know the size of the compressed data before making it.
+*/
+	std::array<size_t, 256> codeLength{};
+
+/**
+* @brief Time of the last write and size of the dictionary file when it was loaded, used to notice that the file has changed.
+*/
+	std::filesystem::file_time_type lastWriteTime;
+	std::uintmax_t fileSize = 0;
+};
+
+/**
+* @brief Dictionaries kept loaded by the service, keyed by the address of the dictionary file.
+*/
+struct DictionaryCache
+{
+	std::mutex mutex;
+	std::map<std::string, std::shared_ptr<const CachedDictionary>> dictionaries;
+
+/**
+* @brief Reads the time of the last write and the size of the dictionary file.
+* @return Returns false if the file does not exist or cannot be examined.
+*/
+	static bool GetFileVersion(const std::string& dictionaryFile, std::filesystem::file_time_type& lastWriteTime, std::uintmax_t& fileSize)
+	{
+		std::error_code errorCode;
+		lastWriteTime = std::filesystem::last_write_time(dictionaryFile, errorCode);
+		if (errorCode)
+			return false;
+		fileSize = std::filesystem::file_size(dictionaryFile, errorCode);
+		return !errorCode;
+	}
+
+/**
+* @brief Makes the cached dictionary out of the map of codes.
+*/
+	static std::shared_ptr<const CachedDictionary> MakeEntry(std::map<char, std::string> dictionary,
+		std::filesystem::file_time_type lastWriteTime, std::uintmax_t fileSize)
+	{
+		auto entry = std::make_shared<CachedDictionary>();
+		entry->lastWriteTime = lastWriteTime;
+		entry->fileSize = fileSize;
+		entry->reversedDictionary = ReverseDictionary(dictionary);
+		for (const auto& el : dictionary)
+		{
+			entry->codeLength[static_cast<unsigned char>(el.first)] = el.second.size();
+		}
+		entry->dictionary = std::move(dictionary);
+		return entry;
+	}
+
+/**
+* @brief Returns the loaded dictionary, reading it from the file the first time and again whenever the file has changed.
+* @return Pointer to the dictionary, nullptr if the file could not be read or holds no codes.
+*/
+	std::shared_ptr<const CachedDictionary> Get(const std::string& dictionaryFile)
+	{
+		std::filesystem::file_time_type lastWriteTime;
+		std::uintmax_t fileSize;
+		if (!GetFileVersion(dictionaryFile, lastWriteTime, fileSize))
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		auto found = dictionaries.find(dictionaryFile);
+		if (found != dictionaries.end() && found->second->lastWriteTime == lastWriteTime && found->second->fileSize == fileSize)
+			return found->second;
+
+		std::map<char, std::string> dictionary = ReadDictionary(dictionaryFile);
+		if (dictionary.empty())
+		{
+			dictionaries.erase(dictionaryFile);
+			return nullptr;
+		}
+		return dictionaries[dictionaryFile] = MakeEntry(std::move(dictionary), lastWriteTime, fileSize);
+	}
+
+/**
+* @brief Replaces the loaded dictionary with a new one that has just been saved to the file.
+*/
+	void Put(const std::string& dictionaryFile, std::map<char, std::string> dictionary)
+	{
+		std::filesystem::file_time_type lastWriteTime;
+		std::uintmax_t fileSize;
+		if (!GetFileVersion(dictionaryFile, lastWriteTime, fileSize))
+			return;
+		std::shared_ptr<const CachedDictionary> entry = MakeEntry(std::move(dictionary), lastWriteTime, fileSize);
+		std::lock_guard<std::mutex> lock(mutex);
+		dictionaries[dictionaryFile] = std::move(entry);
+	}
+};
+
+/**
+* @brief Connection of a single client.
+*/
+struct Connection
+{
+	SocketHandle socket;
+
+/**
+* @brief Requests of this connection that are being handled.
+*/
+	TaskGroup tasks;
+
+/**
+* @brief Guards responses, requestsInFlight and isReading.
+*/
+	std::mutex responsesMutex;
+
+/**
+* @brief Responses waiting for the writer thread, which is the only one sending on the socket.
+*/
+	std::deque<ServiceResponse> responses;
+
+/**
+* @brief Number of requests read but whose responses have not been sent yet.
+*/
+	unsigned int requestsInFlight = 0;
+
+/**
+* @brief Cleared by the reader thread once no more responses will be added.
+*/
+	bool isReading = true;
+
+/**
+* @brief Notified when a response has been added or reading has ended.
+*/
+	std::condition_variable responseAdded;
+
+/**
+* @brief Notified when a response has been sent.
+*/
+	std::condition_variable responseSent;
+
+/**
+* @brief Set by the reader thread once the connection has ended.
+*/
+	std::atomic<bool> isFinished{ false };
+
+	explicit Connection(SocketHandle connectedSocket) : socket(connectedSocket) {}
+	~Connection() { CloseSocket(socket); }
+};
+
+/**
+* @brief State shared by all connections of the service.
+*/
+struct ServiceState
+{
+	WorkStealingPool& pool;
+	std::string socketPath;
+
+/**
+* @brief Canonical path of the directory holding the dictionaries.
+*/
+	std::filesystem::path dictionaryDirectory;
+	DictionaryCache cache;
+	std::atomic<bool> isStopping{ false };
+
+	ServiceState(WorkStealingPool& workPool, const std::string& path, const std::filesystem::path& directory)
+		: pool(workPool), socketPath(path), dictionaryDirectory(directory) {}
+};
+
+/**
+* @brief Resolves the dictionary path of the request and checks that it lies inside the dictionary directory.
+* @details Relative paths start in the dictionary directory, "." and ".." are removed and symbolic links of existing parts are followed,
+* so neither can lead outside of it.
+* @param dictionaryFile Path sent by the client.
+* @param dictionaryDirectory Canonical path of the dictionary directory.
+* @param result Resolved path, passed as a reference.
+* @return Returns true if the path lies inside the dictionary directory, false otherwise.
+*/
+static bool ResolveDictionaryFile(const std::string& dictionaryFile, const std::filesystem::path& dictionaryDirectory, std::string& result)
+{
+	if (dictionaryFile.empty())
+		return false;
+	std::error_code errorCode;
+	std::filesystem::path resolvedPath = std::filesystem::weakly_canonical(dictionaryDirectory / dictionaryFile, errorCode);
+	if (errorCode)
+		return false;
+
+	auto [directoryIt, pathIt] = std::mismatch(dictionaryDirectory.begin(), dictionaryDirectory.end(), resolvedPath.begin(), resolvedPath.end());
+	if (directoryIt != dictionaryDirectory.end() || pathIt == resolvedPath.end())
+		return false;
+	result = resolvedPath.string();
+	return true;
+}
+
+/**
+* @brief Handles the request.
+* @details Compressed data takes one character per bit, so its size is checked against the biggest payload before it is made.
+* Decompressed data is never longer than the codes it is made from.
+* @param request Request to handle.
+* @param state State of the service.
+* @param result String to which the result or the error message is written, passed as a reference.
+* @return Status of the response.
+*/
+static uint8_t HandleRequest(const ServiceRequest& request, ServiceState& state, std::string& result)
+{
+	result.clear();
+	const char* begin = request.payload.data();
+	const char* end = begin + request.payload.size();
+
+	std::string dictionaryFile;
+	if (!ResolveDictionaryFile(request.dictionaryFile, state.dictionaryDirectory, dictionaryFile))
+	{
+		result = "The dictionary \"" + request.dictionaryFile + "\" is not inside the dictionary directory of the service.";
+		return ServiceStatus::Failed;
+	}
+
+	if (request.operation == ServiceOperation::Train)
+	{
+		std::map<char, int> frequencyMap;
+		AddToFrequencyMap(begin, end, frequencyMap);
+		if (frequencyMap.empty())
+		{
+			result = "Nothing to make the dictionary from.";
+			return ServiceStatus::Failed;
+		}
+		std::map<char, std::string> dictionary = CreateDictionary(frequencyMap);
+		if (!SaveDictionary(dictionary, dictionaryFile))
+		{
+			result = "Could not save the dictionary \"" + request.dictionaryFile + "\".";
+			return ServiceStatus::Failed;
+		}
+		state.cache.Put(dictionaryFile, std::move(dictionary));
+		return ServiceStatus::Ok;
+	}
+	if (request.operation != ServiceOperation::Compress && request.operation != ServiceOperation::Decompress)
+	{
+		result = "Unknown operation.";
+		return ServiceStatus::Failed;
+	}
+
+	std::shared_ptr<const CachedDictionary> entry = state.cache.Get(dictionaryFile);
+	if (!entry)
+	{
+		result = "Could not read the dictionary \"" + request.dictionaryFile + "\".";
+		return ServiceStatus::Failed;
+	}
+
+	if (request.operation == ServiceOperation::Compress)
+	{
+		size_t resultLength = 0;
+		for (const char* it = begin; it != end; ++it)
+		{
+			if (*it == '\n')
+			{
+				resultLength++;
+				continue;
+			}
+			size_t codeLength = entry->codeLength[static_cast<unsigned char>(*it)];
+			if (codeLength == 0)
+			{
+				result = "The dictionary has no code for some of the characters.";
+				return ServiceStatus::Failed;
+			}
+			resultLength += codeLength;
+		}
+		if (resultLength > maximumPayloadLength)
+		{
+			result = "The compressed data would be bigger than the biggest response.";
+			return ServiceStatus::Failed;
+		}
+		result.reserve(resultLength);
+		CompressText(begin, end, entry->dictionary, result);
+	}
+	else
+	{
+		DecompressText(begin, end, entry->reversedDictionary, result);
+	}
+	return ServiceStatus::Ok;
+}
+
+/**
+* @brief Wakes the thread blocked on accepting connections by connecting to the service.
+*/
+static void WakeAcceptingThread(const std::string& socketPath)
+{
+	SocketHandle wakingSocket = ConnectToUnixSocket(socketPath);
+	if (wakingSocket != invalidSocket)
+		CloseSocket(wakingSocket);
+}
+
+/**
+* @brief Adds the response to the queue of the writer thread of the connection.
+*/
+static void AddResponse(Connection& connection, ServiceResponse response)
+{
+	{
+		std::lock_guard<std::mutex> lock(connection.responsesMutex);
+		connection.responses.push_back(std::move(response));
+	}
+	connection.responseAdded.notify_one();
+}
+
+/**
+* @brief Sends responses of the connection until the reader thread has ended and all responses have been sent.
+* @details Only this thread sends on the socket, so pool workers never block on a client that does not read its responses.
+* If a response cannot be sent the connection is shut down and the remaining responses are dropped.
+* @param connection Connection to send the responses of.
+*/
+static void WriteResponses(std::shared_ptr<Connection> connection)
+{
+	bool isBroken = false;
+	std::unique_lock<std::mutex> lock(connection->responsesMutex);
+	while (true)
+	{
+		connection->responseAdded.wait(lock, [&connection]() { return !connection->responses.empty() || !connection->isReading; });
+		if (connection->responses.empty())
+			break;
+		ServiceResponse response = std::move(connection->responses.front());
+		connection->responses.pop_front();
+		lock.unlock();
+
+		if (!isBroken && !WriteResponse(connection->socket, response.requestId, response.status, response.payload))
+		{
+			isBroken = true;
+			ShutdownSocket(connection->socket);
+		}
+
+		lock.lock();
+		connection->requestsInFlight--;
+		connection->responseSent.notify_one();
+	}
+}
+
+/**
+* @brief Reads requests of the connection and submits them to the pool until the connection ends.
+* @details At most maximumRequestsInFlight requests are handled or wait to be sent at a time,
+* further requests are not read until a response is sent. Responses are sent by a writer thread of the connection.
+* A request that throws is answered with ServiceStatus::Failed and the message of the exception.
+* @param connection Connection to serve.
+* @param state State of the service.
+*/
+static void ServeConnection(std::shared_ptr<Connection> connection, ServiceState& state)
+{
+	std::thread writer(WriteResponses, connection);
+	bool isQuit = false;
+	ServiceRequest request;
+	while (ReadRequest(connection->socket, request))
+	{
+		{
+			std::unique_lock<std::mutex> lock(connection->responsesMutex);
+			connection->responseSent.wait(lock, [&connection]() { return connection->requestsInFlight < maximumRequestsInFlight; });
+			connection->requestsInFlight++;
+		}
+
+		if (request.operation == ServiceOperation::Quit)
+		{
+			state.pool.WaitFor(connection->tasks);
+			ServiceResponse response;
+			response.requestId = request.requestId;
+			AddResponse(*connection, std::move(response));
+			isQuit = true;
+			break;
+		}
+
+		state.pool.Submit([connection, request = std::move(request), &state]()
+			{
+				ServiceResponse response;
+				response.requestId = request.requestId;
+				try
+				{
+					response.status = HandleRequest(request, state, response.payload);
+				}
+				catch (const std::exception& exception)
+				{
+					response.status = ServiceStatus::Failed;
+					response.payload = std::string("Request has failed: ") + exception.what();
+				}
+				catch (...)
+				{
+					response.status = ServiceStatus::Failed;
+					response.payload = "Request has failed.";
+				}
+				AddResponse(*connection, std::move(response));
+			}, connection->tasks);
+		request = ServiceRequest();
+	}
+
+	state.pool.WaitFor(connection->tasks);
+	{
+		std::lock_guard<std::mutex> lock(connection->responsesMutex);
+		connection->isReading = false;
+	}
+	connection->responseAdded.notify_one();
+	writer.join();
+
+	if (isQuit)
+	{
+		state.isStopping = true;
+		WakeAcceptingThread(state.socketPath);
+	}
+	connection->isFinished = true;
+}
+
+bool RunCompressionService(const std::string& socketPath, const std::string& dictionaryDirectory, unsigned int numberOfThreads)
+{
+	std::error_code errorCode;
+	std::filesystem::path canonicalDirectory = std::filesystem::canonical(dictionaryDirectory, errorCode);
+	if (errorCode || !std::filesystem::is_directory(canonicalDirectory, errorCode))
+	{
+		std::cout << std::endl << "Could not open the dictionary directory \"" << dictionaryDirectory << "\". Aborted." << std::endl;
+		return false;
+	}
+	if (!InitializeSockets())
+		return false;
+	SocketHandle listeningSocket = ListenOnUnixSocket(socketPath);
+	if (listeningSocket == invalidSocket)
+	{
+		std::cout << std::endl << "Could not listen on \"" << socketPath
+			<< "\", the path may be taken by another file or a running service. Aborted." << std::endl;
+		return false;
+	}
+	if (numberOfThreads == 0)
+		numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	WorkStealingPool pool(numberOfThreads);
+	ServiceState state(pool, socketPath, canonicalDirectory);
+	std::list<std::pair<std::shared_ptr<Connection>, std::thread>> connections;
+	std::cout << "Listening on \"" << socketPath << "\" with " << pool.NumberOfWorkers() << " threads, dictionaries in \""
+		<< canonicalDirectory.string() << "\"." << std::endl;
+
+	bool isAcceptingFailed = false;
+	std::chrono::milliseconds backoff(0);
+	while (!state.isStopping)
+	{
+		for (auto it = connections.begin(); it != connections.end();)
+		{
+			if (it->first->isFinished)
+			{
+				it->second.join();
+				it = connections.erase(it);
+			}
+			else
+				++it;
+		}
+		bool isTransientError = false;
+		SocketHandle connectedSocket = AcceptConnection(listeningSocket, isTransientError);
+		if (connectedSocket == invalidSocket)
+		{
+			if (state.isStopping)
+				break;
+			if (!isTransientError)
+			{
+				std::cout << std::endl << "Could not accept connections on \"" << socketPath << "\". Stopping." << std::endl;
+				isAcceptingFailed = true;
+				break;
+			}
+			if (backoff.count() == 0)
+				std::cout << std::endl << "Could not accept a connection on \"" << socketPath << "\". Retrying." << std::endl;
+			backoff = std::min(std::max(backoff * 2, std::chrono::milliseconds(10)), maximumAcceptBackoff);
+			std::this_thread::sleep_for(backoff);
+			continue;
+		}
+		backoff = std::chrono::milliseconds(0);
+		if (state.isStopping)
+		{
+			CloseSocket(connectedSocket);
+			break;
+		}
+
+		auto connection = std::make_shared<Connection>(connectedSocket);
+		connections.emplace_back(connection, std::thread(ServeConnection, connection, std::ref(state)));
+	}
+
+	for (auto& el : connections)
+	{
+		ShutdownSocket(el.first->socket);
+	}
+	for (auto& el : connections)
+	{
+		el.second.join();
+	}
+	connections.clear();
+	CloseSocket(listeningSocket);
+
+	RemoveStaleUnixSocket(socketPath);
+	std::cout << "Service stopped." << std::endl;
+	return !isAcceptingFailed;
+}
@@ -0,0 +1,33 @@
+/**
+*	@file compression_service.h
+*	@brief Declaration of the function running the long-running compression service.
+*	@details The service listens on a Unix domain socket and handles requests framed as described in the service_protocol header.
+*	Dictionaries are read once and kept loaded, together with their reversed versions, so requests do not pay for reading them again,
+*	unless the time of the last write or the size of the file has changed since.
+*	Every connection has its own reader thread, which may receive up to maximumRequestsInFlight requests without waiting for responses, while the requests
+*	themselves are handled on the work-stealing thread pool and responses are sent back by a writer thread of the connection as soon as they are ready.
+*	Dictionary files are only read and written inside the dictionary directory of the service, paths leading outside it are refused.
+*	Requests are coded with huffman's coding and the character alphabet, the same format "-t k" and "-t d" use.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef compression_service_h
+#define compression_service_h
+
+/* -- Includes -- */
+
+/* string library. */
+#include <string>
+
+/**
+* @brief Runs the compression service until it receives the quit request.
+* @param socketPath Path of the Unix domain socket to listen on.
+* @param dictionaryDirectory Directory holding all dictionaries the service may read and write, relative paths of requests start in it.
+* @param numberOfThreads Number of workers of the pool, 0 means the number of hardware threads.
+* @details When accepting a connection fails for a reason that may pass, such as running out of file descriptors,
+* the service waits before trying again, up to a second, and it stops when accepting fails for any other reason.
+* @return Returns true if the service has been stopped by the quit request, false if it could not start or could not accept connections.
+*/
+bool RunCompressionService(const std::string& socketPath, const std::string& dictionaryDirectory, unsigned int numberOfThreads);
+#endif
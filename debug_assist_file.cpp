@@ -35,13 +35,13 @@ void ShowMapCharByInt(const std::map<char, int>& map) {
 		std::cout << std::setw(5) << '\"' << el.first << "\" " << '|' << std::setw(5) << el.second << std::endl;
 	}
 }
-void PrintHuffmanCode(HuffNode* pRoot, std::string code = "")
+void PrintHuffmanCode(HuffNode<char>* pRoot, std::string code = "")
 {
 	if (!pRoot)
 		return;
 	if (!pRoot->isHuffNodeWithoutChar)
 	{
-		std::cout << pRoot->character << ": " << code << '\n';
+		std::cout << pRoot->symbol << ": " << code << '\n';
 	}
 	PrintHuffmanCode(pRoot->leftNode, code + '0');
 	PrintHuffmanCode(pRoot->rightNode, code + '1');
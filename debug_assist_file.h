@@ -61,5 +61,5 @@ void DetectLeaks();
 * @param pRoot HuffNode pointer to the root of the Huffman's binary tree.
 * @param code Not to be used when using the function to display the tree, it's in displaying the codes in the recursive function.
 */
-void PrintHuffmanCode(HuffNode* pRoot, std::string code);
+void PrintHuffmanCode(HuffNode<char>* pRoot, std::string code);
 #endif 
\ No newline at end of file
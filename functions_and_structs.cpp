@@ -33,12 +33,13 @@ std::map<char, int> CreateMap(const std::string& fileName)
 	return resultMap;
 }
 
-std::vector<std::pair<int, char>> CreateVector(const std::map<char, int> takeFromMap)
+template <typename Symbol>
+std::vector<std::pair<int, Symbol>> CreateVector(const std::map<Symbol, int> takeFromMap)
 {
-	std::vector<std::pair<int, char>> resultVector;
-	std::pair<int, char> tempPair;
+	std::vector<std::pair<int, Symbol>> resultVector;
+	std::pair<int, Symbol> tempPair;
 
-	for (const std::pair<char, int> el : takeFromMap)
+	for (const std::pair<Symbol, int> el : takeFromMap)
 	{
 		tempPair.first = el.second;
 		tempPair.second = el.first;
@@ -47,17 +48,18 @@ std::vector<std::pair<int, char>> CreateVector(const std::map<char, int> takeFro
 	return resultVector;
 }
 
-std::vector<std::pair<char, int>> SortVectorMinToMax(const std::vector<std::pair<int, char>>& inVect)
+template <typename Symbol>
+std::vector<std::pair<Symbol, int>> SortVectorMinToMax(const std::vector<std::pair<int, Symbol>>& inVect)
 {
-	std::vector<std::pair<char, int>> resultVector;
+	std::vector<std::pair<Symbol, int>> resultVector;
 
-	std::priority_queue <std::pair<int, char>, std::vector<std::pair<int, char>>, std::greater<std::pair<int, char>>> sortingPriorityQueue;
+	std::priority_queue <std::pair<int, Symbol>, std::vector<std::pair<int, Symbol>>, std::greater<std::pair<int, Symbol>>> sortingPriorityQueue;
 	for (const auto& el : inVect)
 	{
 		sortingPriorityQueue.push(el);
 	}
 
-	std::pair<char, int> tempPair;
+	std::pair<Symbol, int> tempPair;
 
 	while (!sortingPriorityQueue.empty())
 	{
@@ -139,7 +141,8 @@ void DecompressToDiffrentFile(const std::string& fromFile, const std::string& to
 	}
 }
 
-void DeleteHuff(HuffNode*& pRoot)
+template <typename Symbol>
+void DeleteHuff(HuffNode<Symbol>*& pRoot)
 {
 	if (!pRoot)
 		return;
@@ -153,16 +156,18 @@ void DeleteHuff(HuffNode*& pRoot)
 	pRoot->rightNode = nullptr;
 }
 
-void DeleteHuffEntirely(HuffNode*& pRoot)
+template <typename Symbol>
+void DeleteHuffEntirely(HuffNode<Symbol>*& pRoot)
 {
 	DeleteHuff(pRoot);
 	delete(pRoot);
 	pRoot = nullptr;
 }
 
-HuffNode* findMinNode(std::queue<HuffNode*>& leafQueue, std::queue<HuffNode*>& nodeQueue)
+template <typename Symbol>
+HuffNode<Symbol>* findMinNode(std::queue<HuffNode<Symbol>*>& leafQueue, std::queue<HuffNode<Symbol>*>& nodeQueue)
 {
-	HuffNode* temp;
+	HuffNode<Symbol>* temp;
 
 	if (leafQueue.empty()) {
 		temp = nodeQueue.front();
@@ -190,36 +195,43 @@ HuffNode* findMinNode(std::queue<HuffNode*>& leafQueue, std::queue<HuffNode*>& n
 	}
 }
 
-HuffNode* HuffmanCoding(std::vector<std::pair<char, int>>& vect)
+template <typename Symbol>
+HuffNode<Symbol>* HuffmanCoding(std::vector<std::pair<Symbol, int>>& vect)
 {
 	if (vect.empty())
 	{
 		std::cout << "Empty Vector, Failed";
 		return NULL;
 	}
-	std::queue<HuffNode*> leafNodeQueue;
-	std::queue<HuffNode*> regularNodeQueue;
-	for (const std::pair<char, int>& el : vect)
+	std::queue<HuffNode<Symbol>*> leafNodeQueue;
+	std::queue<HuffNode<Symbol>*> regularNodeQueue;
+	for (const std::pair<Symbol, int>& el : vect)
 	{
-		leafNodeQueue.push(new HuffNode(el.first, el.second));
+		leafNodeQueue.push(new HuffNode<Symbol>(el.first, el.second));
+	}
+	if (leafNodeQueue.size() == 1)
+	{
+		HuffNode<Symbol>* onlyLeaf = leafNodeQueue.front();
+		return new HuffNode<Symbol>(onlyLeaf->frequency, onlyLeaf, nullptr);
 	}
 	while (!leafNodeQueue.empty() || regularNodeQueue.size() > 1)
 	{
-		HuffNode* left = findMinNode(leafNodeQueue, regularNodeQueue);
-		HuffNode* right = findMinNode(leafNodeQueue, regularNodeQueue);
-		HuffNode* brandNew = new HuffNode((left->frequency + right->frequency), left, right);
+		HuffNode<Symbol>* left = findMinNode(leafNodeQueue, regularNodeQueue);
+		HuffNode<Symbol>* right = findMinNode(leafNodeQueue, regularNodeQueue);
+		HuffNode<Symbol>* brandNew = new HuffNode<Symbol>((left->frequency + right->frequency), left, right);
 		regularNodeQueue.push(brandNew);
 	}
 	return regularNodeQueue.front();
 }
 
-void MakeDictionary(HuffNode* pRoot, std::map<char, std::string>& resultMap, std::string hold)
+template <typename Symbol>
+void MakeDictionary(HuffNode<Symbol>* pRoot, std::map<Symbol, std::string>& resultMap, std::string hold)
 {
 	if (!pRoot)
 		return;
 	if (!pRoot->isHuffNodeWithoutChar)
 	{
-		resultMap.emplace(pRoot->character, hold);
+		resultMap.emplace(pRoot->symbol, hold);
 	}
 	MakeDictionary(pRoot->leftNode, resultMap, hold + '0');
 	MakeDictionary(pRoot->rightNode, resultMap, hold + '1');
@@ -255,15 +267,169 @@ std::map<char, std::string> ReadDictionary(const std::string& fileName)
 	return resultDictionary;
 }
 
-void SaveDictionary(const std::map<char, std::string>& dictionary, const std::string& fileName)
+bool SaveDictionary(const std::map<char, std::string>& dictionary, const std::string& fileName)
 {
 	std::ofstream outStream(fileName);
-	if (outStream)
+	if (!outStream)
+		return false;
+
+	for (const auto& el : dictionary)
+	{
+		outStream << el.first << ' ' << el.second << std::endl;
+	}
+	outStream.close();
+	return !outStream.fail();
+}
+
+bool ReadFileToString(const std::string& fileName, std::string& result, bool isBinary)
+{
+	result.clear();
+	std::ifstream inFileStream(fileName, isBinary ? std::ios::in | std::ios::binary : std::ios::in);
+	if (!inFileStream)
+		return false;
+
+	char chunk[1 << 16];
+	while (inFileStream.read(chunk, sizeof(chunk)) || inFileStream.gcount() > 0)
+	{
+		result.append(chunk, static_cast<size_t>(inFileStream.gcount()));
+	}
+	if (!isBinary && !result.empty() && result.back() == '\n')
+		result.pop_back();
+	inFileStream.close();
+	return true;
+}
+
+void AddToFrequencyMap(const char* begin, const char* end, std::map<char, int>& resultMap)
+{
+	std::array<int, 256> counts{};
+	for (const char* it = begin; it != end; ++it)
+	{
+		counts[static_cast<unsigned char>(*it)]++;
+	}
+	counts[static_cast<unsigned char>('\n')] = 0;
+
+	for (int i = 0; i < 256; ++i)
+	{
+		if (counts[i])
+			resultMap[static_cast<char>(i)] += counts[i];
+	}
+}
+
+template <typename Symbol>
+std::map<Symbol, std::string> CreateDictionary(const std::map<Symbol, int>& frequencyMap)
+{
+	std::vector<std::pair<int, Symbol>> vectorToStoreFrequencyOfSymbols = CreateVector(frequencyMap);
+	std::vector<std::pair<Symbol, int>> sorterVectorOfSymbolsByFrequency = SortVectorMinToMax(vectorToStoreFrequencyOfSymbols);
+
+	HuffNode<Symbol>* pRoot = HuffmanCoding(sorterVectorOfSymbolsByFrequency);
+	std::map<Symbol, std::string> resultDictionary;
+	MakeDictionary(pRoot, resultDictionary);
+	DeleteHuffEntirely(pRoot);
+	return resultDictionary;
+}
+
+template <typename Symbol>
+std::map<std::string, Symbol> ReverseDictionary(const std::map<Symbol, std::string>& dictionary)
+{
+	std::map<std::string, Symbol> resultDictionary;
+	for (const auto& el : dictionary)
+	{
+		resultDictionary.emplace(el.second, el.first);
+	}
+	return resultDictionary;
+}
+
+void CompressText(const char* begin, const char* end, const std::map<char, std::string>& dictionary, std::string& result)
+{
+	std::array<const std::string*, 256> codes{};
+	for (const auto& el : dictionary)
+	{
+		codes[static_cast<unsigned char>(el.first)] = &el.second;
+	}
+
+	for (const char* it = begin; it != end; ++it)
+	{
+		if (*it == '\n')
+			result += '\n';
+		else if (codes[static_cast<unsigned char>(*it)])
+			result += *codes[static_cast<unsigned char>(*it)];
+	}
+}
+
+void DecompressText(const char* begin, const char* end, const std::map<std::string, char>& reversedDictionary, std::string& result)
+{
+	std::string tempKey;
+	for (const char* it = begin; it != end; ++it)
 	{
-		for (const auto& el : dictionary)
+		if (*it == '\n')
+		{
+			result += '\n';
+			continue;
+		}
+		tempKey += *it;
+		auto found = reversedDictionary.find(tempKey);
+		if (found != reversedDictionary.end())
 		{
-			outStream << el.first << ' ' << el.second << std::endl;
+			result += found->second;
+			tempKey.clear();
 		}
-		outStream.close();
 	}
-}
\ No newline at end of file
+}
+
+template <typename Symbol>
+void AddSymbolsToFrequencyMap(const std::vector<Symbol>& symbols, std::map<Symbol, int>& resultMap)
+{
+	for (const Symbol el : symbols)
+	{
+		resultMap[el]++;
+	}
+}
+
+template <typename Symbol>
+void CompressSymbols(const std::vector<Symbol>& symbols, const std::map<Symbol, std::string>& dictionary, std::string& result)
+{
+	for (const Symbol el : symbols)
+	{
+		auto found = dictionary.find(el);
+		if (found != dictionary.end())
+			result += found->second;
+	}
+}
+
+template <typename Symbol>
+void DecompressSymbols(const std::string& codes, const std::map<std::string, Symbol>& reversedDictionary, std::vector<Symbol>& result)
+{
+	std::string tempKey;
+	for (const char el : codes)
+	{
+		tempKey += el;
+		auto found = reversedDictionary.find(tempKey);
+		if (found != reversedDictionary.end())
+		{
+			result.push_back(found->second);
+			tempKey.clear();
+		}
+	}
+}
+
+/* -- Explicit instantiations for the supported symbol types -- */
+
+#define INSTANTIATE_HUFFMAN_FUNCTIONS(Symbol) \
+	template std::vector<std::pair<int, Symbol>> CreateVector(const std::map<Symbol, int> takeFromMap); \
+	template std::vector<std::pair<Symbol, int>> SortVectorMinToMax(const std::vector<std::pair<int, Symbol>>& inVect); \
+	template void DeleteHuff(HuffNode<Symbol>*& pRoot); \
+	template void DeleteHuffEntirely(HuffNode<Symbol>*& pRoot); \
+	template HuffNode<Symbol>* findMinNode(std::queue<HuffNode<Symbol>*>& leafQueue, std::queue<HuffNode<Symbol>*>& nodeQueue); \
+	template HuffNode<Symbol>* HuffmanCoding(std::vector<std::pair<Symbol, int>>& vect); \
+	template void MakeDictionary(HuffNode<Symbol>* pRoot, std::map<Symbol, std::string>& resultMap, std::string hold); \
+	template std::map<Symbol, std::string> CreateDictionary(const std::map<Symbol, int>& frequencyMap); \
+	template std::map<std::string, Symbol> ReverseDictionary(const std::map<Symbol, std::string>& dictionary); \
+	template void AddSymbolsToFrequencyMap(const std::vector<Symbol>& symbols, std::map<Symbol, int>& resultMap); \
+	template void CompressSymbols(const std::vector<Symbol>& symbols, const std::map<Symbol, std::string>& dictionary, std::string& result); \
+	template void DecompressSymbols(const std::string& codes, const std::map<std::string, Symbol>& reversedDictionary, std::vector<Symbol>& result);
+
+INSTANTIATE_HUFFMAN_FUNCTIONS(char)
+INSTANTIATE_HUFFMAN_FUNCTIONS(uint16_t)
+INSTANTIATE_HUFFMAN_FUNCTIONS(uint32_t)
+
+#undef INSTANTIATE_HUFFMAN_FUNCTIONS
\ No newline at end of file
@@ -2,7 +2,8 @@
 *	@file functions_and_structs.h
 *	@brief Structures and declaration of functions for the project.
 *	@details Contains the HuffNode structure used in the Huffman Compression to create the binary tree from which codes may be read,
-*   as well as declarations of functions used in it.
+*   as well as declarations of functions used in it. Templated functions are defined in functions_and_structs.cpp
+*   and instantiated there for the supported symbol types: 'char', 'uint16_t' and 'uint32_t'.
 *	@author Jakub Daz
 *	@bug No known bugs.
 */
@@ -30,19 +31,28 @@
 /* iostream library.*/
 #include <iostream>
 
+/* array library. */
+#include <array>
+
+/* cstdint library. */
+#include <cstdint>
+
 /**
 * @brief Structure to make nodes and leafes for Huffman's binary tree.
-* @details
+* @details The structure is templated on the type of the symbol, 'char' is used for text files,
+* wider types are used for 16-bit samples and byte pairs (see wide_alphabet header).
+* @tparam Symbol Type of the symbol held by leaf nodes.
 */
+template <typename Symbol>
 struct HuffNode
 {
 /**
-* @brief Character of a node (used for leaf nodes).
+* @brief Symbol of a node (used for leaf nodes).
 */
-	char character;
+	Symbol symbol;
 	
 /**
-* @brief Frequency of the character or characters in associated leaf nodes of this node.
+* @brief Frequency of the symbol or symbols in associated leaf nodes of this node.
 */
 	unsigned int frequency;
 	
@@ -61,10 +71,10 @@ struct HuffNode
 */
 	bool isHuffNodeWithoutChar;
 	
-//! A constructor for leaf nodes (Nodes with characters and without associated pointers).
-	HuffNode(char inputedCharacter, unsigned int inputedFrequency, HuffNode* lftNode = nullptr, HuffNode* rghtNode = nullptr)
+//! A constructor for leaf nodes (Nodes with symbols and without associated pointers).
+	HuffNode(Symbol inputedSymbol, unsigned int inputedFrequency, HuffNode* lftNode = nullptr, HuffNode* rghtNode = nullptr)
 	{
-		character = inputedCharacter;
+		symbol = inputedSymbol;
 		frequency = inputedFrequency;
 		leftNode = lftNode;
 		rightNode = rghtNode;
@@ -74,7 +84,7 @@ struct HuffNode
 //! A constructor for non-leaf nodes ("Regular nodes").
 	HuffNode(unsigned int inputedFrequency, HuffNode* lftNode, HuffNode* rghtNode)
 	{
-		character = NULL;
+		symbol = Symbol();
 		frequency = inputedFrequency;
 		leftNode = lftNode;
 		rightNode = rghtNode;
@@ -92,20 +102,22 @@ std::map<char, int> CreateMap(const std::string& fileName);
 
 /**
 * @brief Creates vector from the frequency map.
-* @details Creates a vector of pairs (pair of int by char) from the frequency map.
+* @details Creates a vector of pairs (pair of int by symbol) from the frequency map.
 * @param takeFromMap Frequency map from which to create vector.
-* @return Vector of pair's int and char
+* @return Vector of pair's int and symbol
 */
-std::vector<std::pair<int, char>> CreateVector(const std::map<char, int> takeFromMap);
+template <typename Symbol>
+std::vector<std::pair<int, Symbol>> CreateVector(const std::map<Symbol, int> takeFromMap);
 
 /**
-* @brief Make vector of pairs (char by int) that is sorted from min to max.
-* @details Creates a vector of pairs (char by int), from a vector of pairs int by char,
+* @brief Make vector of pairs (symbol by int) that is sorted from min to max.
+* @details Creates a vector of pairs (symbol by int), from a vector of pairs int by symbol,
 * that is sorted from smallest int value to biggest int value (non-decreasing pairs).
-* @param inVect Vector of pairs int by char.
-* @return Vector of pair's char by int that is sorted non-decreasingly.
+* @param inVect Vector of pairs int by symbol.
+* @return Vector of pair's symbol by int that is sorted non-decreasingly.
 */
-std::vector<std::pair<char, int>> SortVectorMinToMax(const std::vector<std::pair<int, char>>& inVect);
+template <typename Symbol>
+std::vector<std::pair<Symbol, int>> SortVectorMinToMax(const std::vector<std::pair<int, Symbol>>& inVect);
 
 /**
 * @brief Compress from inputed file to output file and make dictionary.
@@ -130,14 +142,16 @@ void DecompressToDiffrentFile(const std::string& fromFile, const std::string& to
 * @details Recursively delete all nodes and leafes of the huffman's tree except for the root node.
 * @param pRoot pointer to the huffman's trees root.
 */
-void DeleteHuff(HuffNode*& pRoot);
+template <typename Symbol>
+void DeleteHuff(HuffNode<Symbol>*& pRoot);
 
 /**
 * @brief Delete all nodes of huffman tree including the root.
 * Invokes DeleteHuff and then deletes and assignes nullptr to pRoot.
 * @param pRoot pointer to the huffman's trees root.
 */
-void DeleteHuffEntirely(HuffNode*& pRoot);
+template <typename Symbol>
+void DeleteHuffEntirely(HuffNode<Symbol>*& pRoot);
 
 /**
 * @brief Finds the smallest HuffNode in Queues.
@@ -147,14 +161,15 @@ void DeleteHuffEntirely(HuffNode*& pRoot);
 * @param leafQueue Queue of HuffNode's leafes (nodes with chars).
 * @param nodeQueue Queue of Huffnode's regular nodes.
 */
-HuffNode* findMinNode(std::queue<HuffNode*>& leafQueue, std::queue<HuffNode*>& nodeQueue);
+template <typename Symbol>
+HuffNode<Symbol>* findMinNode(std::queue<HuffNode<Symbol>*>& leafQueue, std::queue<HuffNode<Symbol>*>& nodeQueue);
 
 /**
 * @brief Makes huffman's binary tree from a non-decreasing vector.
-* @details Takes a non-decreasing vector of pairs char by int as input and generates a huffman tree from it.
+* @details Takes a non-decreasing vector of pairs symbol by int as input and generates a huffman tree from it.
 * The generation work in the following algorythm:
 * 1. Take an element from the sorted vector.
-* 2. Generate a HuffNode from it using the first variable of the pair as the character of the leaf node, 
+* 2. Generate a HuffNode from it using the first variable of the pair as the symbol of the leaf node, 
 * and second as the frequency of it, push that to the leafQueue node.
 * 3. Repeat steps 1. and 2. untill you have iterated through the entire vector.
 * 4. Find two smallest nodes from the leafQueue and the nodeQueue
@@ -162,20 +177,23 @@ HuffNode* findMinNode(std::queue<HuffNode*>& leafQueue, std::queue<HuffNode*>& n
 * 6. Push the brand new node pointer onto the nodeQueue
 * 7. Repeat steps 4. through 6. untill leafQueue is empty and nodeQueue has no more than one element
 * 8. On the nodeQueue there will be the pointer to the root, return it as the result.
-* @param vect Vector of pairs (char by int) sorted in an non-decreasing manner.
+* If there is only one symbol, the root gets its leaf as the left node, so the symbol still gets a code of one bit.
+* @param vect Vector of pairs (symbol by int) sorted in an non-decreasing manner.
 * @return Pointer to the root.
 */
-HuffNode* HuffmanCoding(std::vector<std::pair<char, int>>& vect);
+template <typename Symbol>
+HuffNode<Symbol>* HuffmanCoding(std::vector<std::pair<Symbol, int>>& vect);
 
 /**
-* @brief Makes a map where keys are characters and values are corresponding huffman codes.
+* @brief Makes a map where keys are symbols and values are corresponding huffman codes.
 * @details Recursively goes through a huffman tree and emplaces onto the given map corresponding pair of
-* characters and their codes.
+* symbols and their codes.
 * @param pRoot Pointer to the root of the tree.
-* @param resultMap Map onto which characters and their codes will be emplaced, passed as a reference.
+* @param resultMap Map onto which symbols and their codes will be emplaced, passed as a reference.
 * @param hold String which is used through recursive huffman tree traversal to hold onto the value of codes.
 */
-void MakeDictionary(HuffNode* pRoot, std::map<char, std::string>& resultMap, std::string hold = "");
+template <typename Symbol>
+void MakeDictionary(HuffNode<Symbol>* pRoot, std::map<Symbol, std::string>& resultMap, std::string hold = "");
 
 /**
 * @brief Function which assists during ReadDictionary.
@@ -200,6 +218,95 @@ std::map<char, std::string> ReadDictionary(const std::string& fileName);
 * whose addres has been given as the parameter.
 * @param dictionary Map of characters as keys and their codes as the values.
 * @oaram fileName Addres to the file in which the dictionary will be saved.
+* @return Returns true if the whole dictionary has been written, false otherwise.
+*/
+bool SaveDictionary(const std::map<char, std::string>& dictionary, const std::string& fileName);
+/**
+* @brief Reads the whole file into a string.
+* @details Reads the file in text mode the same way std::getline based functions see it and drops a single trailing
+* new line character, so the content matches what CompressToDiffrentFile and DecompressToDiffrentFile would process.
+* When isBinary is set the file is read byte for byte and nothing is dropped.
+* The result string is cleared first and its capacity is reused, so it may be passed in again as a scratch buffer.
+* @param fileName Addres of the file to read.
+* @param result String to which the content is read, passed as a reference.
+* @param isBinary Whether to read the file in binary mode.
+* @return Returns true if the file could be opened, false otherwise.
+*/
+bool ReadFileToString(const std::string& fileName, std::string& result, bool isBinary = false);
+
+/**
+* @brief Adds frequencies of characters from a range of text to the frequency map.
+* @details Counts every character between begin and end apart from the new line character,
+* which is how CreateMap counts characters of a file. Counts are added to values already present in the map,
+* so a map can be built out of several ranges.
+* @param begin Pointer to the first character of the range.
+* @param end Pointer past the last character of the range.
+* @param resultMap Frequency map onto which frequencies are added, passed as a reference.
+*/
+void AddToFrequencyMap(const char* begin, const char* end, std::map<char, int>& resultMap);
+
+/**
+* @brief Makes the dictionary of huffman codes from the frequency map.
+* @details Creates the vector from the frequency map, sorts it, builds huffman's binary tree, reads codes from it and deletes the tree.
+* @param frequencyMap Frequency map of symbols.
+* @return Dictionary - Map with symbols as keys and their codes as values.
+*/
+template <typename Symbol>
+std::map<Symbol, std::string> CreateDictionary(const std::map<Symbol, int>& frequencyMap);
+
+/**
+* @brief Makes the reversed dictionary used in decompression.
+* @param dictionary Map with symbols as keys and their codes as values.
+* @return Map with codes as keys and their symbols as values.
+*/
+template <typename Symbol>
+std::map<std::string, Symbol> ReverseDictionary(const std::map<Symbol, std::string>& dictionary);
+
+/**
+* @brief Compresses a range of text and appends the result to the string.
+* @details Every character is replaced with its code, new line characters are copied as they are,
+* so the compressed ranges of one text may be joined together in order.
+* @param begin Pointer to the first character of the range.
+* @param end Pointer past the last character of the range.
+* @param dictionary Map with characters as keys and their codes as values.
+* @param result String to which the compressed range is appended, passed as a reference.
+*/
+void CompressText(const char* begin, const char* end, const std::map<char, std::string>& dictionary, std::string& result);
+
+/**
+* @brief Decompresses a range of compressed text and appends the result to the string.
+* @details The range should start and end on the line boundary, as codes never go over the new line character.
+* @param begin Pointer to the first character of the range.
+* @param end Pointer past the last character of the range.
+* @param reversedDictionary Map with codes as keys and their characters as values.
+* @param result String to which the decompressed range is appended, passed as a reference.
+*/
+void DecompressText(const char* begin, const char* end, const std::map<std::string, char>& reversedDictionary, std::string& result);
+
+/**
+* @brief Adds frequencies of symbols to the frequency map.
+* @details Unlike AddToFrequencyMap no symbol is skipped, as wide symbols do not form lines.
+* @param symbols Symbols to count.
+* @param resultMap Frequency map onto which frequencies are added, passed as a reference.
+*/
+template <typename Symbol>
+void AddSymbolsToFrequencyMap(const std::vector<Symbol>& symbols, std::map<Symbol, int>& resultMap);
+
+/**
+* @brief Compresses symbols and appends their codes to the string.
+* @param symbols Symbols to compress.
+* @param dictionary Map with symbols as keys and their codes as values.
+* @param result String to which codes are appended, passed as a reference.
+*/
+template <typename Symbol>
+void CompressSymbols(const std::vector<Symbol>& symbols, const std::map<Symbol, std::string>& dictionary, std::string& result);
+
+/**
+* @brief Decompresses codes and appends decoded symbols to the vector.
+* @param codes String of codes.
+* @param reversedDictionary Map with codes as keys and their symbols as values.
+* @param result Vector to which symbols are appended, passed as a reference.
 */
-void SaveDictionary(const std::map<char, std::string>& dictionary, const std::string& fileName);
+template <typename Symbol>
+void DecompressSymbols(const std::string& codes, const std::map<std::string, Symbol>& reversedDictionary, std::vector<Symbol>& result);
 #endif
\ No newline at end of file
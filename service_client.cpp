@@ -0,0 +1,134 @@
+/**
+*	@file service_client.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the service_client header.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* chrono library. */
+#include <chrono>
+
+/* filesystem library. */
+#include <filesystem>
+
+/* service_client header file. */
+#include "service_client.h"
+
+/* functions_and_structs header file. */
+#include "functions_and_structs.h"
+
+bool ConnectToService(const std::string& socketPath, ServiceClient& client)
+{
+	if (!InitializeSockets())
+		return false;
+	client.socket = ConnectToUnixSocket(socketPath);
+	return client.socket != invalidSocket;
+}
+
+void DisconnectFromService(ServiceClient& client)
+{
+	if (client.socket != invalidSocket)
+		CloseSocket(client.socket);
+	client.socket = invalidSocket;
+}
+
+uint32_t SendServiceRequest(ServiceClient& client, char operation, const std::string& dictionaryFile, const std::string& payload)
+{
+	uint32_t requestId = client.nextRequestId++;
+	if (client.nextRequestId == 0)
+		client.nextRequestId = 1;
+	return WriteRequest(client.socket, requestId, operation, dictionaryFile, payload) ? requestId : 0;
+}
+
+bool ReceiveServiceResponse(ServiceClient& client, ServiceResponse& response)
+{
+	return ReadResponse(client.socket, response);
+}
+
+bool RunServiceClient(const std::string& socketPath, char operation, const std::string& fromFile, const std::string& toFile,
+	const std::string& dictionaryFile, unsigned int numberOfRequests)
+{
+	ServiceClient client;
+	if (!ConnectToService(socketPath, client))
+	{
+		std::cout << std::endl << "Could not connect to \"" << socketPath << "\". Aborted." << std::endl;
+		return false;
+	}
+
+	std::string payload;
+	if (operation != ServiceOperation::Quit && !ReadFileToString(fromFile, payload))
+	{
+		std::cout << std::endl << "Could not open \"" << fromFile << "\". Aborted." << std::endl;
+		DisconnectFromService(client);
+		return false;
+	}
+	if (operation == ServiceOperation::Quit || numberOfRequests == 0)
+		numberOfRequests = 1;
+
+	std::string absoluteDictionaryFile;
+	if (operation != ServiceOperation::Quit)
+	{
+		std::error_code errorCode;
+		absoluteDictionaryFile = std::filesystem::absolute(dictionaryFile, errorCode).string();
+		if (errorCode)
+		{
+			std::cout << std::endl << "Inappropriate dictionary path \"" << dictionaryFile << "\". Aborted." << std::endl;
+			DisconnectFromService(client);
+			return false;
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	unsigned int sent = 0, received = 0, failed = 0;
+	bool isSendFailed = false;
+	ServiceResponse response;
+	while (received < numberOfRequests)
+	{
+		while (!isSendFailed && sent < numberOfRequests && sent - received < maximumRequestsInFlight)
+		{
+			if (!SendServiceRequest(client, operation, absoluteDictionaryFile, payload))
+				isSendFailed = true;
+			else
+				sent++;
+		}
+		if (sent == received || !ReceiveServiceResponse(client, response))
+			break;
+		received++;
+		if (response.status != ServiceStatus::Ok && ++failed == 1)
+			std::cout << std::endl << "Request " << response.requestId << " failed: " << response.payload << std::endl;
+	}
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	DisconnectFromService(client);
+
+	if (isSendFailed)
+	{
+		std::cout << std::endl << "Could not send the request to the service. Aborted." << std::endl;
+		return false;
+	}
+	if (received < numberOfRequests)
+	{
+		std::cout << std::endl << "Connection to the service has ended. Aborted." << std::endl;
+		return false;
+	}
+	if (!failed && (operation == ServiceOperation::Compress || operation == ServiceOperation::Decompress))
+	{
+		std::ofstream toFileStream(toFile);
+		if (toFileStream)
+		{
+			toFileStream.write(response.payload.data(), response.payload.size());
+			toFileStream.close();
+		}
+		if (toFileStream.fail())
+		{
+			std::cout << std::endl << "Could not save the result to \"" << toFile << "\". Aborted." << std::endl;
+			return false;
+		}
+	}
+
+	std::cout << "Requests: " << received << ", failed: " << failed << ", average time per request: "
+		<< milliseconds / received << " ms" << std::endl;
+	return failed == 0;
+}
@@ -0,0 +1,85 @@
+/**
+*	@file service_client.h
+*	@brief Structure and declaration of functions of the client of the compression service.
+*	@details Contains the ServiceClient structure and functions to send pipelined requests to the service
+*	and receive responses, as well as the function used by the "-t client" switch.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef service_client_h
+#define service_client_h
+
+/* -- Includes -- */
+
+/* string library. */
+#include <string>
+
+/* service_protocol header file. */
+#include "service_protocol.h"
+
+/**
+* @brief Connection to the compression service.
+*/
+struct ServiceClient
+{
+/**
+* @brief Socket connected to the service.
+*/
+	SocketHandle socket = invalidSocket;
+
+/**
+* @brief Id given to the next request.
+*/
+	uint32_t nextRequestId = 1;
+};
+
+/**
+* @brief Connects the client to the service.
+* @param socketPath Path of the Unix domain socket the service listens on.
+* @param client Client to connect, passed as a reference.
+* @return Returns true if the client has connected, false otherwise.
+*/
+bool ConnectToService(const std::string& socketPath, ServiceClient& client);
+
+/**
+* @brief Closes the connection of the client.
+* @param client Client to disconnect, passed as a reference.
+*/
+void DisconnectFromService(ServiceClient& client);
+
+/**
+* @brief Sends the request without waiting for the response.
+* @details Many requests may be sent before responses are received, responses carry the id returned here.
+* @param client Connected client.
+* @param operation One of the ServiceOperation values.
+* @param dictionaryFile Address of the dictionary file on the machine of the service.
+* @param payload Data of the request.
+* @return Id of the request, 0 if it could not be sent.
+*/
+uint32_t SendServiceRequest(ServiceClient& client, char operation, const std::string& dictionaryFile, const std::string& payload);
+
+/**
+* @brief Waits for the next response from the service.
+* @param client Connected client.
+* @param response Received response, passed as a reference.
+* @return Returns true if a response has been received, false if the connection has ended.
+*/
+bool ReceiveServiceResponse(ServiceClient& client, ServiceResponse& response);
+
+/**
+* @brief Sends the file to the service the given number of times and saves the result.
+* @details At most a fixed number of requests is kept in flight, so large payloads cannot fill socket buffers on both sides.
+* Prints the number of requests and the average time per request on the console, as well as the error of the first failed request.
+* @param socketPath Path of the Unix domain socket the service listens on.
+* @param operation One of the ServiceOperation values.
+* @param fromFile Address of the inputed file, not used by the quit request.
+* @param toFile Address of the file where the result is to be saved, not used by the train and quit requests.
+* @param dictionaryFile Address of the dictionary file on the machine of the service, sent as an absolute path,
+* which has to lie inside the dictionary directory of the service.
+* @param numberOfRequests Number of times the request is sent.
+* @return Returns true if all requests have succeeded, false otherwise.
+*/
+bool RunServiceClient(const std::string& socketPath, char operation, const std::string& fromFile, const std::string& toFile,
+	const std::string& dictionaryFile, unsigned int numberOfRequests);
+#endif
@@ -0,0 +1,290 @@
+/**
+*	@file service_protocol.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the service_protocol header.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* cerrno library. */
+#include <cerrno>
+
+/* cstring library. */
+#include <cstring>
+
+/* filesystem library. */
+#include <filesystem>
+
+/* service_protocol header file. */
+#include "service_protocol.h"
+
+#ifdef _WIN32
+/* afunix header, Unix domain sockets for Winsock. */
+#include <afunix.h>
+
+#pragma comment(lib, "Ws2_32.lib")
+#else
+/* socket header, BSD sockets. */
+#include <sys/socket.h>
+
+/* un header, Unix domain socket addresses. */
+#include <sys/un.h>
+
+/* unistd header, close function. */
+#include <unistd.h>
+#endif
+
+/* Size of the header of every frame. */
+static constexpr size_t frameHeaderSize = 12;
+
+#ifdef MSG_NOSIGNAL
+/* Writing to a closed connection should fail instead of killing the process with SIGPIPE. */
+static constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+static constexpr int sendFlags = 0;
+#endif
+
+/**
+* @brief Writes the value into four bytes in little-endian order.
+*/
+static void PutUint32(char* destination, uint32_t value)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		destination[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+	}
+}
+
+/**
+* @brief Reads the value from four bytes in little-endian order.
+*/
+static uint32_t GetUint32(const char* source)
+{
+	uint32_t result = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		result |= static_cast<uint32_t>(static_cast<unsigned char>(source[i])) << (8 * i);
+	}
+	return result;
+}
+
+/**
+* @brief Fills the Unix domain socket address with the path.
+* @return Returns false if the path is too long for the address.
+*/
+static bool MakeUnixAddress(const std::string& socketPath, sockaddr_un& address)
+{
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+		return false;
+	std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+	return true;
+}
+
+/**
+* @brief Sends all bytes, repeating the send call as many times as needed.
+*/
+static bool SendAll(SocketHandle socket, const char* data, size_t length)
+{
+	while (length > 0)
+	{
+		int chunk = static_cast<int>(length > (1u << 30) ? (1u << 30) : length);
+		auto sent = send(socket, data, chunk, sendFlags);
+		if (sent <= 0)
+			return false;
+		data += sent;
+		length -= static_cast<size_t>(sent);
+	}
+	return true;
+}
+
+/**
+* @brief Receives exactly the given number of bytes, repeating the recv call as many times as needed.
+*/
+static bool ReceiveAll(SocketHandle socket, char* data, size_t length)
+{
+	while (length > 0)
+	{
+		int chunk = static_cast<int>(length > (1u << 30) ? (1u << 30) : length);
+		auto received = recv(socket, data, chunk, 0);
+		if (received <= 0)
+			return false;
+		data += received;
+		length -= static_cast<size_t>(received);
+	}
+	return true;
+}
+
+bool InitializeSockets()
+{
+#ifdef _WIN32
+	WSADATA wsaData;
+	return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+#else
+	return true;
+#endif
+}
+
+void CloseSocket(SocketHandle socket)
+{
+#ifdef _WIN32
+	closesocket(socket);
+#else
+	close(socket);
+#endif
+}
+
+void ShutdownSocket(SocketHandle socket)
+{
+#ifdef _WIN32
+	shutdown(socket, SD_BOTH);
+#else
+	shutdown(socket, SHUT_RDWR);
+#endif
+}
+
+bool RemoveStaleUnixSocket(const std::string& socketPath)
+{
+	std::error_code errorCode;
+	std::filesystem::file_status status = std::filesystem::symlink_status(socketPath, errorCode);
+	if (!std::filesystem::exists(status))
+		return true;
+	if (!std::filesystem::is_socket(status))
+		return false;
+
+	SocketHandle probingSocket = ConnectToUnixSocket(socketPath);
+	if (probingSocket != invalidSocket)
+	{
+		CloseSocket(probingSocket);
+		return false;
+	}
+	return std::filesystem::remove(socketPath, errorCode) && !errorCode;
+}
+
+SocketHandle ListenOnUnixSocket(const std::string& socketPath)
+{
+	sockaddr_un address;
+	if (!MakeUnixAddress(socketPath, address))
+		return invalidSocket;
+
+	if (!RemoveStaleUnixSocket(socketPath))
+		return invalidSocket;
+
+	SocketHandle listeningSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listeningSocket == invalidSocket)
+		return invalidSocket;
+	if (bind(listeningSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listeningSocket, SOMAXCONN) != 0)
+	{
+		CloseSocket(listeningSocket);
+		return invalidSocket;
+	}
+	return listeningSocket;
+}
+
+SocketHandle AcceptConnection(SocketHandle listeningSocket, bool& isTransientError)
+{
+	SocketHandle connectedSocket = accept(listeningSocket, nullptr, nullptr);
+	isTransientError = false;
+	if (connectedSocket != invalidSocket)
+		return connectedSocket;
+
+#ifdef _WIN32
+	int error = WSAGetLastError();
+	isTransientError = error == WSAEINTR || error == WSAECONNRESET || error == WSAEMFILE || error == WSAENOBUFS || error == WSAEWOULDBLOCK;
+#else
+	int error = errno;
+	isTransientError = error == EINTR || error == ECONNABORTED || error == EMFILE || error == ENFILE || error == ENOBUFS
+		|| error == ENOMEM || error == EPROTO || error == EAGAIN || error == EWOULDBLOCK;
+#endif
+	return invalidSocket;
+}
+
+SocketHandle ConnectToUnixSocket(const std::string& socketPath)
+{
+	sockaddr_un address;
+	if (!MakeUnixAddress(socketPath, address))
+		return invalidSocket;
+
+	SocketHandle connectedSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (connectedSocket == invalidSocket)
+		return invalidSocket;
+	if (connect(connectedSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		CloseSocket(connectedSocket);
+		return invalidSocket;
+	}
+	return connectedSocket;
+}
+
+bool WriteRequest(SocketHandle socket, uint32_t requestId, char operation, const std::string& dictionaryFile, const std::string& payload)
+{
+	if (payload.size() > maximumPayloadLength || dictionaryFile.size() > 0xFFFF)
+		return false;
+
+	char header[frameHeaderSize] = {};
+	PutUint32(header, static_cast<uint32_t>(payload.size()));
+	PutUint32(header + 4, requestId);
+	header[8] = operation;
+	header[10] = static_cast<char>(dictionaryFile.size() & 0xFF);
+	header[11] = static_cast<char>(dictionaryFile.size() >> 8);
+
+	return SendAll(socket, header, frameHeaderSize)
+		&& SendAll(socket, dictionaryFile.data(), dictionaryFile.size())
+		&& SendAll(socket, payload.data(), payload.size());
+}
+
+bool WriteRequest(SocketHandle socket, const ServiceRequest& request)
+{
+	return WriteRequest(socket, request.requestId, request.operation, request.dictionaryFile, request.payload);
+}
+
+bool ReadRequest(SocketHandle socket, ServiceRequest& request)
+{
+	char header[frameHeaderSize];
+	if (!ReceiveAll(socket, header, frameHeaderSize))
+		return false;
+
+	uint32_t payloadLength = GetUint32(header);
+	if (payloadLength > maximumPayloadLength)
+		return false;
+	request.requestId = GetUint32(header + 4);
+	request.operation = header[8];
+	size_t dictionaryLength = static_cast<unsigned char>(header[10]) | (static_cast<size_t>(static_cast<unsigned char>(header[11])) << 8);
+
+	request.dictionaryFile.resize(dictionaryLength);
+	request.payload.resize(payloadLength);
+	return ReceiveAll(socket, request.dictionaryFile.data(), dictionaryLength)
+		&& ReceiveAll(socket, request.payload.data(), payloadLength);
+}
+
+bool WriteResponse(SocketHandle socket, uint32_t requestId, uint8_t status, const std::string& payload)
+{
+	if (payload.size() > maximumPayloadLength)
+		return false;
+
+	char header[frameHeaderSize] = {};
+	PutUint32(header, static_cast<uint32_t>(payload.size()));
+	PutUint32(header + 4, requestId);
+	header[8] = static_cast<char>(status);
+
+	return SendAll(socket, header, frameHeaderSize) && SendAll(socket, payload.data(), payload.size());
+}
+
+bool ReadResponse(SocketHandle socket, ServiceResponse& response)
+{
+	char header[frameHeaderSize];
+	if (!ReceiveAll(socket, header, frameHeaderSize))
+		return false;
+
+	uint32_t payloadLength = GetUint32(header);
+	if (payloadLength > maximumPayloadLength)
+		return false;
+	response.requestId = GetUint32(header + 4);
+	response.status = static_cast<uint8_t>(header[8]);
+
+	response.payload.resize(payloadLength);
+	return ReceiveAll(socket, response.payload.data(), payloadLength);
+}
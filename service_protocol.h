@@ -0,0 +1,212 @@
+/**
+*	@file service_protocol.h
+*	@brief Structures and declaration of functions shared by the compression service and its client.
+*	@details Contains a thin layer over Unix domain sockets (Winsock with afunix.h on Windows, BSD sockets elsewhere)
+*	and the framing of requests and responses. Every frame starts with a fixed 12 byte header of little-endian fields,
+*	so a client may send many requests without waiting and match responses by their request id:
+*	1. Request - payload length (4 bytes), request id (4 bytes), operation (1 byte), reserved (1 byte),
+*	dictionary path length (2 bytes), followed by the dictionary path and the payload.
+*	2. Response - payload length (4 bytes), request id (4 bytes), status (1 byte), reserved (3 bytes), followed by the payload,
+*	which holds the result, or the error message if the status is not ServiceStatus::Ok.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef service_protocol_h
+#define service_protocol_h
+
+/* -- Includes -- */
+
+/* cstdint library. */
+#include <cstdint>
+
+/* string library. */
+#include <string>
+
+#ifdef _WIN32
+/* @def Keeps windows.h, which winsock2.h includes, from defining min and max macros that clash with std::min and std::max. */
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+/* winsock2 header, Windows sockets. */
+#include <winsock2.h>
+#endif
+
+#ifdef _WIN32
+/**
+* @brief Handle of a socket.
+*/
+using SocketHandle = SOCKET;
+
+/**
+* @brief Value of a handle that does not refer to any socket.
+*/
+constexpr SocketHandle invalidSocket = INVALID_SOCKET;
+#else
+using SocketHandle = int;
+constexpr SocketHandle invalidSocket = -1;
+#endif
+
+/**
+* @brief Biggest payload accepted in a single frame.
+*/
+constexpr uint32_t maximumPayloadLength = 1u << 30;
+
+/**
+* @brief Number of requests of a single connection in flight at most.
+* @details The client does not send more before it receives responses and the service does not read more before it sends them,
+* so large payloads cannot fill socket buffers on both sides.
+*/
+constexpr unsigned int maximumRequestsInFlight = 16;
+
+/**
+* @brief Operations that can be requested from the service.
+*/
+namespace ServiceOperation
+{
+	constexpr char Compress = 'k';		//!< Compress the payload with the dictionary, respond with codes.
+	constexpr char Decompress = 'd';	//!< Decompress codes in the payload with the dictionary, respond with data.
+	constexpr char Train = 't';			//!< Make the dictionary from the payload, save it and keep it loaded.
+	constexpr char Quit = 'q';			//!< Stop the service.
+}
+
+/**
+* @brief Statuses of responses.
+*/
+namespace ServiceStatus
+{
+	constexpr uint8_t Ok = 0;			//!< Request has been handled, the payload holds the result.
+	constexpr uint8_t Failed = 1;		//!< Request could not be handled, the payload holds the error message.
+}
+
+/**
+* @brief Request sent to the service.
+*/
+struct ServiceRequest
+{
+/**
+* @brief Id chosen by the client, copied into the response.
+*/
+	uint32_t requestId = 0;
+
+/**
+* @brief One of the ServiceOperation values.
+*/
+	char operation = 0;
+
+/**
+* @brief Address of the dictionary file on the machine of the service.
+*/
+	std::string dictionaryFile;
+
+/**
+* @brief Data to compress, codes to decompress or data to make the dictionary from.
+*/
+	std::string payload;
+};
+
+/**
+* @brief Response sent by the service.
+*/
+struct ServiceResponse
+{
+/**
+* @brief Id of the request this is the response to.
+*/
+	uint32_t requestId = 0;
+
+/**
+* @brief One of the ServiceStatus values.
+*/
+	uint8_t status = ServiceStatus::Ok;
+
+/**
+* @brief Result of the request or the error message.
+*/
+	std::string payload;
+};
+
+/**
+* @brief Initializes sockets, needed once per process on Windows, does nothing elsewhere.
+* @return Returns true if sockets can be used, false otherwise.
+*/
+bool InitializeSockets();
+
+/**
+* @brief Closes the socket.
+* @param socket Socket to close.
+*/
+void CloseSocket(SocketHandle socket);
+
+/**
+* @brief Stops sending and receiving on the socket, which wakes threads blocked on it.
+* @param socket Socket to shut down.
+*/
+void ShutdownSocket(SocketHandle socket);
+
+/**
+* @brief Removes the Unix domain socket left at the path by a service that is no longer running.
+* @details Only a socket nobody answers on is removed, any other file at the path is left untouched.
+* @param socketPath Path of the socket.
+* @return Returns true if nothing is left at the path, false if the path is taken by another file or a running service.
+*/
+bool RemoveStaleUnixSocket(const std::string& socketPath);
+
+/**
+* @brief Makes a socket listening on the Unix domain socket path.
+* @details A socket left at the path by a previous run is removed first with RemoveStaleUnixSocket,
+* if the path is taken by anything else nothing is made.
+* @param socketPath Path of the socket.
+* @return Listening socket, invalidSocket if it could not be made.
+*/
+SocketHandle ListenOnUnixSocket(const std::string& socketPath);
+
+/**
+* @brief Accepts a connection on the listening socket.
+* @param listeningSocket Socket made by ListenOnUnixSocket.
+* @param isTransientError Set to true if accepting has failed for a reason that may pass, such as running out of file descriptors
+* or a connection aborted by the client, passed as a reference.
+* @return Connected socket, invalidSocket if accepting has failed.
+*/
+SocketHandle AcceptConnection(SocketHandle listeningSocket, bool& isTransientError);
+
+/**
+* @brief Connects to the Unix domain socket path.
+* @param socketPath Path of the socket.
+* @return Connected socket, invalidSocket if it could not connect.
+*/
+SocketHandle ConnectToUnixSocket(const std::string& socketPath);
+
+/**
+* @brief Sends the request in a single frame.
+* @return Returns true if the whole frame has been sent, false otherwise.
+*/
+bool WriteRequest(SocketHandle socket, const ServiceRequest& request);
+
+/**
+* @brief Sends the request in a single frame.
+* @details Fields are passed separately, so the payload can be sent straight from the caller's buffer without being copied.
+* @return Returns true if the whole frame has been sent, false otherwise.
+*/
+bool WriteRequest(SocketHandle socket, uint32_t requestId, char operation, const std::string& dictionaryFile, const std::string& payload);
+
+/**
+* @brief Receives a single request frame.
+* @return Returns true if a whole and correct frame has been received, false on the end of the connection or an error.
+*/
+bool ReadRequest(SocketHandle socket, ServiceRequest& request);
+
+/**
+* @brief Sends the response in a single frame.
+* @details The payload is passed separately, so it can be sent straight from a reused buffer.
+* @return Returns true if the whole frame has been sent, false otherwise.
+*/
+bool WriteResponse(SocketHandle socket, uint32_t requestId, uint8_t status, const std::string& payload);
+
+/**
+* @brief Receives a single response frame.
+* @return Returns true if a whole and correct frame has been received, false on the end of the connection or an error.
+*/
+bool ReadResponse(SocketHandle socket, ServiceResponse& response);
+#endif
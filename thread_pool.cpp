@@ -0,0 +1,194 @@
+/**
+*	@file thread_pool.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of member functions of the WorkStealingPool class declared in the thread_pool header.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* chrono library. */
+#include <chrono>
+
+/* iostream library. */
+#include <iostream>
+
+/* thread_pool header file. */
+#include "thread_pool.h"
+
+/* Pool to which the current thread belongs as a worker, nullptr for any other thread. */
+static thread_local const WorkStealingPool* currentPool = nullptr;
+
+/* Index of the queue of the current thread, valid only when currentPool is set. */
+static thread_local size_t currentQueue = 0;
+
+WorkStealingPool::WorkStealingPool(unsigned int numberOfWorkers)
+{
+	if (numberOfWorkers == 0)
+		numberOfWorkers = 1;
+
+	for (unsigned int i = 0; i <= numberOfWorkers; ++i)
+	{
+		queues.push_back(std::make_unique<WorkerQueue>());
+	}
+	for (unsigned int i = 0; i < numberOfWorkers; ++i)
+	{
+		workers.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		isStopping = true;
+	}
+	sleepCondition.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void WorkStealingPool::Submit(std::function<void()> task, TaskGroup& group)
+{
+	group.unfinishedTasks++;
+	auto wrappedTask = [this, task = std::move(task), &group]()
+	{
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			std::cout << std::endl << "Task has thrown an exception." << std::endl;
+		}
+		if (--group.unfinishedTasks == 0)
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			groupFinishedCondition.notify_all();
+		}
+	};
+
+	size_t queueIndex = (currentPool == this) ? currentQueue : queues.size() - 1;
+	queuedTasks++;
+	{
+		std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+		queues[queueIndex]->tasks.push_back({ std::move(wrappedTask), &group });
+	}
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_one();
+}
+
+void WorkStealingPool::WaitFor(TaskGroup& group)
+{
+	while (group.unfinishedTasks > 0)
+	{
+		if (TryRunOneTaskOf(group))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		groupFinishedCondition.wait_for(lock, std::chrono::milliseconds(1), [&]()
+			{
+				return group.unfinishedTasks == 0;
+			});
+	}
+}
+
+unsigned int WorkStealingPool::NumberOfWorkers() const
+{
+	return static_cast<unsigned int>(workers.size());
+}
+
+void WorkStealingPool::WorkerLoop(size_t workerIndex)
+{
+	currentPool = this;
+	currentQueue = workerIndex;
+
+	while (true)
+	{
+		if (TryRunOneTask(workerIndex))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [&]()
+			{
+				return isStopping || queuedTasks > 0;
+			});
+		if (isStopping && queuedTasks == 0)
+			return;
+	}
+}
+
+bool WorkStealingPool::TryRunOneTask(size_t ownQueue)
+{
+	std::function<void()> task;
+
+	{
+		std::lock_guard<std::mutex> lock(queues[ownQueue]->mutex);
+		if (!queues[ownQueue]->tasks.empty())
+		{
+			task = std::move(queues[ownQueue]->tasks.back().task);
+			queues[ownQueue]->tasks.pop_back();
+		}
+	}
+	for (size_t i = 1; !task && i < queues.size(); ++i)
+	{
+		WorkerQueue& victim = *queues[(ownQueue + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.front().task);
+			victim.tasks.pop_front();
+		}
+	}
+	if (!task)
+		return false;
+
+	queuedTasks--;
+	task();
+	return true;
+}
+
+bool WorkStealingPool::TryRunOneTaskOf(const TaskGroup& group)
+{
+	std::function<void()> task;
+	size_t ownQueue = (currentPool == this) ? currentQueue : queues.size() - 1;
+
+	{
+		WorkerQueue& queue = *queues[ownQueue];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		for (auto it = queue.tasks.rbegin(); it != queue.tasks.rend(); ++it)
+		{
+			if (it->group == &group)
+			{
+				task = std::move(it->task);
+				queue.tasks.erase(std::next(it).base());
+				break;
+			}
+		}
+	}
+	for (size_t i = 1; !task && i < queues.size(); ++i)
+	{
+		WorkerQueue& victim = *queues[(ownQueue + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		for (auto it = victim.tasks.begin(); it != victim.tasks.end(); ++it)
+		{
+			if (it->group == &group)
+			{
+				task = std::move(it->task);
+				victim.tasks.erase(it);
+				break;
+			}
+		}
+	}
+	if (!task)
+		return false;
+
+	queuedTasks--;
+	task();
+	return true;
+}
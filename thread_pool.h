@@ -0,0 +1,160 @@
+/**
+*	@file thread_pool.h
+*	@brief Work-stealing thread pool used by the batch mode.
+*	@details Contains the WorkStealingPool class and the TaskGroup structure used to wait for a set of submitted tasks.
+*	Every worker owns its own queue of tasks, it takes tasks from the back of its own queue
+*	and when that is empty it steals from the front of the queues of other workers.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef thread_pool_h
+#define thread_pool_h
+
+/* -- Includes -- */
+
+/* atomic library. */
+#include <atomic>
+
+/* condition_variable library. */
+#include <condition_variable>
+
+/* deque library. */
+#include <deque>
+
+/* functional library. */
+#include <functional>
+
+/* memory library. */
+#include <memory>
+
+/* mutex library. */
+#include <mutex>
+
+/* thread library. */
+#include <thread>
+
+/* vector library. */
+#include <vector>
+
+/**
+* @brief Group of tasks that can be waited for.
+* @details Every task submitted with the group increments the counter and decrements it once it has been run.
+*/
+struct TaskGroup
+{
+/**
+* @brief Number of tasks of the group that have not been run yet.
+*/
+	std::atomic<size_t> unfinishedTasks{ 0 };
+};
+
+/**
+* @brief Thread pool in which idle workers steal tasks from busy ones.
+* @details Tasks submitted from a worker go onto that worker's queue, so a job that splits itself into smaller tasks
+* keeps them close, while other workers that have run out of work steal them. Tasks submitted from any other thread
+* go onto a separate queue from which every worker takes.
+*/
+class WorkStealingPool
+{
+public:
+//! A constructor that starts given number of workers (at least one).
+	explicit WorkStealingPool(unsigned int numberOfWorkers);
+
+//! A destructor that waits for the workers to finish remaining tasks and joins them.
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+/**
+* @brief Submits the task to the pool.
+* @param task Task to run.
+* @param group Group to which the task belongs.
+*/
+	void Submit(std::function<void()> task, TaskGroup& group);
+
+/**
+* @brief Waits until all tasks of the group have been run.
+* @details The waiting thread does not sleep while tasks of the group are queued, it runs them itself,
+* so a task may wait for the tasks it has submitted without blocking a worker. Tasks of other groups are left to the workers,
+* so an unrelated job never runs nested on the stack of a waiting one.
+* @param group Group to wait for.
+*/
+	void WaitFor(TaskGroup& group);
+
+/**
+* @brief Returns the number of workers of the pool.
+*/
+	unsigned int NumberOfWorkers() const;
+
+private:
+/**
+* @brief Task waiting in a queue together with the group it belongs to.
+*/
+	struct QueuedTask
+	{
+		std::function<void()> task;
+		const TaskGroup* group = nullptr;
+	};
+
+/**
+* @brief Queue of tasks belonging to one worker.
+*/
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<QueuedTask> tasks;
+	};
+
+/**
+* @brief Main loop of the worker with the given index.
+*/
+	void WorkerLoop(size_t workerIndex);
+
+/**
+* @brief Takes one task, from own queue first and then from the other queues, and runs it.
+* @param ownQueue Index of the queue to take from first.
+* @return Returns true if a task has been run, false if all queues were empty.
+*/
+	bool TryRunOneTask(size_t ownQueue);
+
+/**
+* @brief Takes one task of the group, from the back of own queue first and then from the other queues, and runs it.
+* @param group Group the task has to belong to.
+* @return Returns true if a task has been run, false if no task of the group was queued.
+*/
+	bool TryRunOneTaskOf(const TaskGroup& group);
+
+/**
+* @brief Queues of the workers, the last one is for tasks submitted from outside of the pool.
+*/
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+/**
+* @brief Threads of the workers.
+*/
+	std::vector<std::thread> workers;
+
+/**
+* @brief Number of tasks that are queued in all queues.
+*/
+	std::atomic<size_t> queuedTasks{ 0 };
+
+/**
+* @brief Set when the pool is being destroyed.
+*/
+	std::atomic<bool> isStopping{ false };
+
+/**
+* @brief Mutex and condition variable on which idle workers sleep.
+*/
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+
+/**
+* @brief Condition variable, used with sleepMutex, on which threads waiting for a group sleep.
+*/
+	std::condition_variable groupFinishedCondition;
+};
+#endif
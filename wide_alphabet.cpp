@@ -0,0 +1,263 @@
+/**
+*	@file wide_alphabet.cpp
+*	@brief File containing the functions outlined in this file's header.
+*	@details Contains bodies of functions declared in the wide_alphabet header.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+/* -- Includes -- */
+
+/* algorithm library. */
+#include <algorithm>
+
+/* sstream library. */
+#include <sstream>
+
+/* wide_alphabet header file. */
+#include "wide_alphabet.h"
+
+/* functions_and_structs header file. */
+#include "functions_and_structs.h"
+
+/* Symbols of byte pairs start after the symbols of single bytes. */
+static constexpr uint32_t digramSymbolOffset = 256;
+
+/**
+* @brief Saves the dictionary of wide symbols to a file.
+* @param dictionary Map of symbols as keys and their codes as the values.
+* @param alphabet Alphabet saved in the first line.
+* @param numberOfBytes Size of the original file saved in the first line.
+* @param fileName Addres to the file in which the dictionary will be saved.
+* @return Returns true if the whole dictionary has been written, false otherwise.
+*/
+template <typename Symbol>
+static bool SaveWideDictionary(const std::map<Symbol, std::string>& dictionary, Alphabet alphabet, size_t numberOfBytes, const std::string& fileName)
+{
+	std::ofstream outStream(fileName);
+	if (!outStream)
+		return false;
+
+	outStream << AlphabetName(alphabet) << ' ' << numberOfBytes << std::endl;
+	for (const auto& el : dictionary)
+	{
+		outStream << static_cast<unsigned long>(el.first) << ' ' << el.second << std::endl;
+	}
+	outStream.close();
+	return !outStream.fail();
+}
+
+/**
+* @brief Reads the dictionary of wide symbols from the file and returns it reversed.
+* @param fileName Addres of the dictionary file.
+* @param alphabet Alphabet the dictionary is expected to be saved for.
+* @param numberOfBytes Size of the original file read from the first line, passed as a reference.
+* @param resultDictionary Map with codes as keys and their symbols as values, passed as a reference.
+* @return Returns true if the file could be opened and it has been saved for the given alphabet, false otherwise.
+*/
+template <typename Symbol>
+static bool ReadWideDictionary(const std::string& fileName, Alphabet alphabet, size_t& numberOfBytes, std::map<std::string, Symbol>& resultDictionary)
+{
+	std::ifstream inFileStream(fileName);
+	if (!inFileStream)
+		return false;
+
+	std::string name;
+	if (!(inFileStream >> name >> numberOfBytes) || name != AlphabetName(alphabet))
+		return false;
+
+	unsigned long symbol;
+	std::string code;
+	while (inFileStream >> symbol >> code)
+	{
+		resultDictionary.emplace(code, static_cast<Symbol>(symbol));
+	}
+	inFileStream.close();
+	return true;
+}
+
+/**
+* @brief Compresses wide symbols, saves the dictionary and appends codes to the string.
+*/
+template <typename Symbol>
+static bool CompressSymbolsWithDictionary(const std::vector<Symbol>& symbols, Alphabet alphabet, size_t numberOfBytes,
+	const std::string& dictionaryFile, std::string& outputBuffer)
+{
+	std::map<Symbol, int> frequencyMap;
+	AddSymbolsToFrequencyMap(symbols, frequencyMap);
+
+	std::map<Symbol, std::string> dictionary;
+	if (!frequencyMap.empty())
+		dictionary = CreateDictionary(frequencyMap);
+	if (!SaveWideDictionary(dictionary, alphabet, numberOfBytes, dictionaryFile))
+		return false;
+
+	CompressSymbols(symbols, dictionary, outputBuffer);
+	return true;
+}
+
+bool ParseAlphabet(const std::string& name, Alphabet& result)
+{
+	if (name == "8")
+		result = Alphabet::Byte;
+	else if (name == "16")
+		result = Alphabet::Word16;
+	else if (name == "dg")
+		result = Alphabet::Digram;
+	else
+		return false;
+	return true;
+}
+
+std::string AlphabetName(Alphabet alphabet)
+{
+	return alphabet == Alphabet::Word16 ? "16" : (alphabet == Alphabet::Digram ? "dg" : "8");
+}
+
+std::vector<uint16_t> MakeWord16Symbols(const std::string& data)
+{
+	std::vector<uint16_t> resultSymbols;
+	resultSymbols.reserve((data.size() + 1) / 2);
+	for (size_t i = 0; i < data.size(); i += 2)
+	{
+		uint16_t low = static_cast<unsigned char>(data[i]);
+		uint16_t high = (i + 1 < data.size()) ? static_cast<unsigned char>(data[i + 1]) : 0;
+		resultSymbols.push_back(static_cast<uint16_t>(low | (high << 8)));
+	}
+	return resultSymbols;
+}
+
+std::string ExpandWord16Symbols(const std::vector<uint16_t>& symbols, size_t numberOfBytes)
+{
+	std::string resultData;
+	resultData.reserve(symbols.size() * 2);
+	for (const uint16_t el : symbols)
+	{
+		resultData += static_cast<char>(el & 0xFF);
+		resultData += static_cast<char>(el >> 8);
+	}
+	if (resultData.size() > numberOfBytes)
+		resultData.resize(numberOfBytes);
+	return resultData;
+}
+
+std::vector<uint32_t> MakeDigramSymbols(const std::string& data, size_t maximumNumberOfDigrams)
+{
+	std::vector<unsigned int> pairCounts(1 << 16, 0);
+	for (size_t i = 0; i + 1 < data.size(); ++i)
+	{
+		pairCounts[(static_cast<unsigned char>(data[i]) << 8) | static_cast<unsigned char>(data[i + 1])]++;
+	}
+
+	std::vector<std::pair<unsigned int, uint32_t>> frequentPairs;
+	for (uint32_t pair = 0; pair < pairCounts.size(); ++pair)
+	{
+		if (pairCounts[pair] >= 2)
+			frequentPairs.push_back({ pairCounts[pair], pair });
+	}
+	size_t numberOfDigrams = std::min(maximumNumberOfDigrams, frequentPairs.size());
+	std::partial_sort(frequentPairs.begin(), frequentPairs.begin() + numberOfDigrams, frequentPairs.end(), std::greater<std::pair<unsigned int, uint32_t>>());
+
+	std::vector<bool> isDigram(1 << 16, false);
+	for (size_t i = 0; i < numberOfDigrams; ++i)
+	{
+		isDigram[frequentPairs[i].second] = true;
+	}
+
+	std::vector<uint32_t> resultSymbols;
+	resultSymbols.reserve(data.size());
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		uint32_t first = static_cast<unsigned char>(data[i]);
+		if (i + 1 < data.size())
+		{
+			uint32_t pair = (first << 8) | static_cast<unsigned char>(data[i + 1]);
+			if (isDigram[pair])
+			{
+				resultSymbols.push_back(digramSymbolOffset + pair);
+				++i;
+				continue;
+			}
+		}
+		resultSymbols.push_back(first);
+	}
+	return resultSymbols;
+}
+
+std::string ExpandDigramSymbols(const std::vector<uint32_t>& symbols)
+{
+	std::string resultData;
+	resultData.reserve(symbols.size() * 2);
+	for (const uint32_t el : symbols)
+	{
+		if (el < digramSymbolOffset)
+		{
+			resultData += static_cast<char>(el);
+			continue;
+		}
+		uint32_t pair = el - digramSymbolOffset;
+		resultData += static_cast<char>(pair >> 8);
+		resultData += static_cast<char>(pair & 0xFF);
+	}
+	return resultData;
+}
+
+bool CompressWide(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer)
+{
+	outputBuffer.clear();
+	if (!ReadFileToString(fromFile, inputBuffer, true))
+		return false;
+
+	bool isSaved = false;
+	if (alphabet == Alphabet::Word16)
+		isSaved = CompressSymbolsWithDictionary(MakeWord16Symbols(inputBuffer), alphabet, inputBuffer.size(), dictionaryFile, outputBuffer);
+	else if (alphabet == Alphabet::Digram)
+		isSaved = CompressSymbolsWithDictionary(MakeDigramSymbols(inputBuffer), alphabet, inputBuffer.size(), dictionaryFile, outputBuffer);
+	if (!isSaved)
+		return false;
+
+	std::ofstream toFileStream(toFile);
+	if (!toFileStream)
+		return false;
+	toFileStream.write(outputBuffer.data(), outputBuffer.size());
+	toFileStream.close();
+	return !toFileStream.fail();
+}
+
+bool DecompressWide(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer)
+{
+	outputBuffer.clear();
+	if (!ReadFileToString(fromFile, inputBuffer))
+		return false;
+
+	size_t numberOfBytes = 0;
+	if (alphabet == Alphabet::Word16)
+	{
+		std::map<std::string, uint16_t> reversedDictionary;
+		if (!ReadWideDictionary(dictionaryFile, alphabet, numberOfBytes, reversedDictionary))
+			return false;
+		std::vector<uint16_t> symbols;
+		DecompressSymbols(inputBuffer, reversedDictionary, symbols);
+		outputBuffer = ExpandWord16Symbols(symbols, numberOfBytes);
+	}
+	else if (alphabet == Alphabet::Digram)
+	{
+		std::map<std::string, uint32_t> reversedDictionary;
+		if (!ReadWideDictionary(dictionaryFile, alphabet, numberOfBytes, reversedDictionary))
+			return false;
+		std::vector<uint32_t> symbols;
+		DecompressSymbols(inputBuffer, reversedDictionary, symbols);
+		outputBuffer = ExpandDigramSymbols(symbols);
+	}
+	else
+		return false;
+
+	std::ofstream toFileStream(toFile, std::ios::out | std::ios::binary);
+	if (!toFileStream)
+		return false;
+	toFileStream.write(outputBuffer.data(), outputBuffer.size());
+	toFileStream.close();
+	return !toFileStream.fail();
+}
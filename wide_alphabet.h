@@ -0,0 +1,114 @@
+/**
+*	@file wide_alphabet.h
+*	@brief Declaration of functions for coding files with alphabets wider than a single character.
+*	@details Contains the Alphabet enumeration and declarations of functions which turn a file into wide symbols,
+*	code them with the templated huffman functions from the functions_and_structs header and turn them back.
+*	Two wide alphabets are supported:
+*	1. 16-bit samples - the file is read as little-endian 'uint16_t' values (sensor data, PCM samples).
+*	2. Digrams - the most frequent byte pairs become single 'uint32_t' symbols, all other bytes stay as they are.
+*	Wide files are read in binary mode and codes are saved without new lines. The dictionary file starts with a line
+*	holding the name of the alphabet and the size of the original file, followed by lines of a symbol (written as a number),
+*	a space, and its code.
+*	@author Jakub Daz
+*	@bug No known bugs.
+*/
+
+#ifndef wide_alphabet_h
+#define wide_alphabet_h
+
+/* -- Includes -- */
+
+/* cstdint library. */
+#include <cstdint>
+
+/* string library. */
+#include <string>
+
+/* vector library. */
+#include <vector>
+
+/**
+* @brief Alphabet of symbols the file is coded with.
+*/
+enum class Alphabet
+{
+	Byte,	//!< Single characters, the original text format.
+	Word16,	//!< Little-endian 16-bit samples.
+	Digram	//!< Single bytes and frequent byte pairs.
+};
+
+/**
+* @brief Reads the alphabet from the argument of the "-a" switch.
+* @param name Argument of the switch, "8", "16" or "dg".
+* @param result Alphabet read from the argument, passed as a reference.
+* @return Returns true if the argument names an alphabet, false otherwise.
+*/
+bool ParseAlphabet(const std::string& name, Alphabet& result);
+
+/**
+* @brief Returns the name of the alphabet, the same one that is used as the argument of the "-a" switch.
+* @param alphabet Alphabet to name.
+* @return Name of the alphabet saved in the first line of the dictionary.
+*/
+std::string AlphabetName(Alphabet alphabet);
+
+/**
+* @brief Turns bytes into 16-bit samples.
+* @details Every two bytes are read as one little-endian sample, an odd last byte becomes a sample with the high byte set to zero.
+* @param data Bytes of the file.
+* @return Vector of samples.
+*/
+std::vector<uint16_t> MakeWord16Symbols(const std::string& data);
+
+/**
+* @brief Turns 16-bit samples back into bytes.
+* @param symbols Samples to turn into bytes.
+* @param numberOfBytes Size of the original file, used to drop the padding byte of an odd sized file.
+* @return Bytes of the file.
+*/
+std::string ExpandWord16Symbols(const std::vector<uint16_t>& symbols, size_t numberOfBytes);
+
+/**
+* @brief Turns bytes into symbols where frequent byte pairs are single symbols.
+* @details Counts every pair of neighbouring bytes and picks at most maximumNumberOfDigrams pairs that appear at least twice,
+* most frequent first. The data is then read from left to right, a picked pair becomes the symbol 256 + (first byte * 256 + second byte),
+* any other byte becomes the symbol equal to its value.
+* @param data Bytes of the file.
+* @param maximumNumberOfDigrams Maximum number of pairs to be coded as single symbols.
+* @return Vector of symbols.
+*/
+std::vector<uint32_t> MakeDigramSymbols(const std::string& data, size_t maximumNumberOfDigrams = 256);
+
+/**
+* @brief Turns symbols made by MakeDigramSymbols back into bytes.
+* @param symbols Symbols to turn into bytes.
+* @return Bytes of the file.
+*/
+std::string ExpandDigramSymbols(const std::vector<uint32_t>& symbols);
+
+/**
+* @brief Compresses the file with a wide alphabet, saves compressed data to out-file and creates a dictionary.
+* @param fromFile Address of the inputed file.
+* @param toFile Address of the file where data is to be saved.
+* @param dictionaryFile Address of the file where dictionary is to be saved.
+* @param alphabet Wide alphabet to use, Alphabet::Byte is not handled here.
+* @param inputBuffer Scratch string for the content of the inputed file, passed as a reference so it can be reused.
+* @param outputBuffer Scratch string for the compressed data, passed as a reference so it can be reused.
+* @return Returns true if the files could be opened and the output file and the dictionary have been written, false otherwise.
+*/
+bool CompressWide(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer);
+
+/**
+* @brief Decompresses the file compressed with a wide alphabet with the use of its dictionary.
+* @param fromFile Address of the inputed file.
+* @param toFile Address of the file where data is to be saved.
+* @param dictionaryFile Address of the file where the dictionary is located.
+* @param alphabet Wide alphabet the file has been compressed with, it has to match the one saved in the dictionary.
+* @param inputBuffer Scratch string for the content of the inputed file, passed as a reference so it can be reused.
+* @param outputBuffer Scratch string for the decompressed data, passed as a reference so it can be reused.
+* @return Returns true if the files could be opened, the dictionary matches the alphabet and the output file has been written, false otherwise.
+*/
+bool DecompressWide(const std::string& fromFile, const std::string& toFile, const std::string& dictionaryFile, Alphabet alphabet,
+	std::string& inputBuffer, std::string& outputBuffer);
+#endif